@@ -0,0 +1,52 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Animation/EnemyAnimInstance.h"
+
+
+void FEnemyAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	const AEnemy* Enemy = Cast<AEnemy>(InAnimInstance->TryGetPawnOwner());
+	if (Enemy == nullptr) { return; }
+
+	AwarenessLevel = Enemy->GetEnemyAwarenessLevel();
+	CombatState = Enemy->GetEnemyCombatState();
+	DeathPose = Enemy->DeathPose;
+	bAlive = Enemy->GetAlive();
+	bIsRagdoll = Enemy->bIsRagdoll;
+	bIncapacitated = Enemy->bIncapacitated;
+	bStaggered = Enemy->bStaggered;
+	bMouthOpen = Enemy->bMouthOpen;
+
+	bHasLookAtTarget = Enemy->bCanLookAtPlayer && Enemy->CombatTarget != nullptr;
+	LookAtLocation = bHasLookAtTarget ? Enemy->CombatTarget->GetActorLocation() : FVector::ZeroVector;
+
+	Velocity = Enemy->GetVelocity();
+	ActorTransform = Enemy->GetActorTransform();
+}
+
+
+void FEnemyAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	const FVector LocalVelocity = ActorTransform.InverseTransformVectorNoScale(Velocity);
+	Speed = LocalVelocity.Size2D();
+	bIsMoving = Speed > KINDA_SMALL_NUMBER;
+	Direction = bIsMoving ? FMath::RadiansToDegrees(FMath::Atan2(LocalVelocity.Y, LocalVelocity.X)) : 0.f;
+
+	if (bHasLookAtTarget)
+	{
+		const FRotator LocalLookAt = ActorTransform.InverseTransformPositionNoScale(LookAtLocation).Rotation();
+		LookAtYaw = LocalLookAt.Yaw;
+		LookAtPitch = LocalLookAt.Pitch;
+	}
+
+	else
+	{
+		LookAtYaw = 0.f;
+		LookAtPitch = 0.f;
+	}
+}
@@ -0,0 +1,113 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "../Enemies/Enemy.h"
+#include "EnemyAnimInstance.generated.h"
+
+/**
+ *  enemy state for the anim graph. gathered from the owning AEnemy on the game thread (PreUpdate), anything derived
+ *  from it is worked out in Update, which runs on a worker thread along with the graph itself
+ */
+USTRUCT(BlueprintType)
+struct FEnemyAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FEnemyAnimInstanceProxy() : FAnimInstanceProxy() {}
+	FEnemyAnimInstanceProxy(UAnimInstance* Instance) : FAnimInstanceProxy(Instance) {}
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+	/*
+	*  copied from the enemy
+	*/
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	EEnemyAwarenessLevel AwarenessLevel = EEnemyAwarenessLevel::EAL_Passive;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	EEnemyCombatState CombatState = EEnemyCombatState::ECS_Idle;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	TEnumAsByte<EDeathPose> DeathPose = EDP_BackwardPose1;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bAlive = true;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bIsRagdoll = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bIncapacitated = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bStaggered = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bMouthOpen = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bHasLookAtTarget = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	FVector LookAtLocation = FVector::ZeroVector;
+
+	/*
+	*  derived (worker thread)
+	*/
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	float Speed = 0.f;
+
+	// movement direction relative to facing, -180..180
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	float Direction = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	bool bIsMoving = false;
+
+	// look at target relative to facing (aim offset input)
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	float LookAtYaw = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy")
+	float LookAtPitch = 0.f;
+
+protected:
+
+	FVector Velocity = FVector::ZeroVector;
+	FTransform ActorTransform = FTransform::Identity;
+};
+
+// proxies are owned by their anim instance, never copied
+template<>
+struct TStructOpsTypeTraits<FEnemyAnimInstanceProxy> : public TStructOpsTypeTraitsBase2<FEnemyAnimInstanceProxy>
+{
+	enum { WithCopy = false };
+};
+
+
+/**
+ *  native base for enemy anim BPs. the graph reads Proxy.* (thread safe), so the anim BP can have multi-threaded
+ *  animation update enabled and keep its event graph empty
+ */
+UCLASS(Transient, Blueprintable)
+class ESCAPEROOMPROJECT_API UEnemyAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+protected:
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Enemy", meta = (AllowPrivateAccess = "true"))
+	FEnemyAnimInstanceProxy Proxy;
+
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+	friend struct FEnemyAnimInstanceProxy;
+};
@@ -0,0 +1,45 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Animation/EnemyMontageTable.h"
+#include "../Enemies/EnemyArchetype.h"
+
+
+void FHitReactTable::Build(UAnimMontage* TorsoMontage, UAnimMontage* LimbMontage, UAnimMontage* CrawlingMontage)
+{
+	Torso[0].Build(TorsoMontage);
+	Torso[1].Build(CrawlingMontage);
+
+	// no crawling version of a direction: keep the standing one
+	for (int32 Direction = 0; Direction < 4; ++Direction)
+	{
+		if (!Torso[1].Sections[Direction].IsValid()) { Torso[1].Sections[Direction] = Torso[0].Sections[Direction]; }
+	}
+
+	const TPair<EBoneHitReactValue, FName> LimbSections[] =
+	{
+		{ EBoneHitReactValue::EBHR_Head, FName("Head") },
+		{ EBoneHitReactValue::EBHR_LeftArm, FName("LeftArm") },
+		{ EBoneHitReactValue::EBHR_RightArm, FName("RightArm") },
+		{ EBoneHitReactValue::EBHR_LeftLeg, FName("LeftLeg") },
+		{ EBoneHitReactValue::EBHR_RightLeg, FName("RightLeg") },
+	};
+
+	for (const TPair<EBoneHitReactValue, FName>& LimbSection : LimbSections)
+	{
+		FMontageSection (&Entry)[2] = Limb[(int32)LimbSection.Key];
+		Entry[0] = FMontageSection::Resolve(LimbMontage, LimbSection.Value);
+		Entry[1] = FMontageSection::Resolve(CrawlingMontage, LimbSection.Value);
+		if (!Entry[1].IsValid()) { Entry[1] = Entry[0]; }
+	}
+}
+
+
+void FEnemyMontageTable::Build(const UEnemyArchetype& Source)
+{
+	HitReacts.Build(Source.HitReactsTorso, Source.HitReactsLimbs, Source.HitReactsCrawling);
+	AttackClose.Build(Source.AttackCloseMontage, Source.AttackCloseMontageSections);
+	AttackDistance.Build(Source.AttackDistanceMontage, Source.AttackDistanceMontageSections);
+	CrawlingAttack.Build(Source.CrawlingAttackMontage, Source.CrawlingAttackMontageSections);
+	DeathBackward.Build(Source.DeathMontage, Source.DeathMontageBackwardOnlySections);
+}
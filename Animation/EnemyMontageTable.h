@@ -0,0 +1,42 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Animation/MontageSectionTable.h"
+#include "../Enemies/Enemy.h"
+
+/**
+ *  an enemy type's hit reacts, keyed by (bone, direction, incapacitated). directional reacts come from the torso montage,
+ *  limb reacts (the stronger, every-other-hit ones) from the limb montage. while incapacitated the crawling montage's
+ *  section of the same name is used, or the standing one if it has none
+ */
+struct FHitReactTable
+{
+	// [incapacitated]
+	FDirectionalMontageSections Torso[2];
+
+	// [bone][incapacitated]; invalid for the torso
+	FMontageSection Limb[(int32)EBoneHitReactValue::EBHR_MAX][2];
+
+	void Build(UAnimMontage* TorsoMontage, UAnimMontage* LimbMontage, UAnimMontage* CrawlingMontage);
+
+	FORCEINLINE const FMontageSection& GetTorsoReact(ELastHitDirection Direction, bool bIncapacitated) const
+	{ return Torso[bIncapacitated ? 1 : 0].Get((int32)Direction); }
+
+	FORCEINLINE const FMontageSection& GetLimbReact(EBoneHitReactValue Bone, bool bIncapacitated) const
+	{ return Limb[FMath::Clamp((int32)Bone, 0, (int32)EBoneHitReactValue::EBHR_MAX - 1)][bIncapacitated ? 1 : 0]; }
+};
+
+
+// every montage section an enemy plays in code, resolved once per enemy type (see UEnemyArchetype::GetMontageTable)
+struct FEnemyMontageTable
+{
+	FHitReactTable HitReacts;
+	FMontageSectionList AttackClose;
+	FMontageSectionList AttackDistance;
+	FMontageSectionList CrawlingAttack;
+	FMontageSectionList DeathBackward;
+
+	void Build(const class UEnemyArchetype& Source);
+};
@@ -0,0 +1,60 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Animation/MontageSectionTable.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+
+
+FMontageSection FMontageSection::Resolve(UAnimMontage* Montage, const FName& SectionName)
+{
+	FMontageSection Section;
+	if (Montage == nullptr) { return Section; }
+
+	const int32 Index = Montage->GetSectionIndex(SectionName);
+	if (Index == INDEX_NONE) { return Section; }
+
+	Section.Montage = Montage;
+	Section.Index = Index;
+	Section.StartTime = Montage->GetAnimCompositeSection(Index).GetTime();
+	Section.Length = Montage->GetSectionLength(Index);
+	return Section;
+}
+
+
+float FMontageSection::Play(UAnimInstance* AnimInstance, float PlayRate) const
+{
+	if (!IsValid()) { return 0.f; }
+
+	// starting at the section's time is what jumping to it by name does, minus the name lookup
+	if (AnimInstance) { AnimInstance->Montage_Play(Montage, PlayRate, EMontagePlayReturnType::MontageLength, StartTime); }
+	return Length;
+}
+
+
+void FMontageSectionList::Build(UAnimMontage* Montage, const TArray<FName>& SectionNames)
+{
+	Sections.Reset(SectionNames.Num());
+	for (const FName& SectionName : SectionNames)
+	{
+		const FMontageSection Section = FMontageSection::Resolve(Montage, SectionName);
+		if (Section.IsValid()) { Sections.Add(Section); }
+	}
+}
+
+
+const FMontageSection* FMontageSectionList::PickRandom() const
+{
+	if (Sections.Num() <= 0) { return nullptr; }
+
+	return &Sections[FMath::RandRange(0, Sections.Num() - 1)];
+}
+
+
+void FDirectionalMontageSections::Build(UAnimMontage* Montage)
+{
+	Sections[0] = FMontageSection::Resolve(Montage, FName("FromFront"));
+	Sections[1] = FMontageSection::Resolve(Montage, FName("FromBack"));
+	Sections[2] = FMontageSection::Resolve(Montage, FName("FromLeft"));
+	Sections[3] = FMontageSection::Resolve(Montage, FName("FromRight"));
+}
@@ -0,0 +1,51 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimInstance;
+class UAnimMontage;
+
+// a montage section resolved to its index (+ timing) once, so it can be played without any name lookups
+struct FMontageSection
+{
+	UAnimMontage* Montage = nullptr;
+	int32 Index = INDEX_NONE;
+	float StartTime = 0.f;
+	float Length = 0.f;
+
+	FORCEINLINE bool IsValid() const { return Montage != nullptr && Index != INDEX_NONE; }
+
+	// invalid if the montage is missing or has no such section
+	static FMontageSection Resolve(UAnimMontage* Montage, const FName& SectionName);
+
+	// play the montage from this section's start; returns the section length (0 if invalid)
+	float Play(UAnimInstance* AnimInstance, float PlayRate = 1.f) const;
+};
+
+
+// a montage's usable sections (e.g., attack variations), resolved up front
+struct FMontageSectionList
+{
+	TArray<FMontageSection> Sections;
+
+	// names that don't resolve are dropped
+	void Build(UAnimMontage* Montage, const TArray<FName>& SectionNames);
+
+	// nullptr if empty
+	const FMontageSection* PickRandom() const;
+};
+
+
+// FromFront/FromBack/FromLeft/FromRight sections, indexed by hit direction (front, back, left, right; the order of both
+// ELastHitDirection and EHitDirection)
+struct FDirectionalMontageSections
+{
+	FMontageSection Sections[4];
+
+	void Build(UAnimMontage* Montage);
+
+	// out of range directions play the front section
+	FORCEINLINE const FMontageSection& Get(int32 Direction) const { return Sections[Direction >= 0 && Direction < 4 ? Direction : 0]; }
+};
@@ -0,0 +1,44 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Animation/PlayerAnimInstance.h"
+
+
+void FPlayerAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	const APlayerCharacter* Player = Cast<APlayerCharacter>(InAnimInstance->TryGetPawnOwner());
+	if (Player == nullptr) { return; }
+
+	MovementStatus = Player->MovementStatus;
+	DeathPose = Player->PlayerDeathPose;
+	bAlive = Player->bAlive;
+	bIdle = Player->bIdle;
+	bCrouched = Player->bIsCrouched;
+	bAiming = Player->bWantsToAim;
+	bTurning = Player->bTurning;
+	bPushing = Player->bPushing;
+	bInCinematic = Player->bInCinematic;
+	bHasWeaponEquipped = Player->bHasWeaponEquipped;
+	bHasFlashlightEquipped = Player->bHasFlashlightEquipped;
+	bFlashlightOn = Player->bFlashlightOn;
+
+	Velocity = Player->GetVelocity();
+	ActorRotation = Player->GetActorRotation();
+	ControlRotation = Player->GetControlRotation();
+}
+
+
+void FPlayerAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	const FVector LocalVelocity = ActorRotation.UnrotateVector(Velocity);
+	Speed = LocalVelocity.Size2D();
+	Direction = Speed > KINDA_SMALL_NUMBER ? FMath::RadiansToDegrees(FMath::Atan2(LocalVelocity.Y, LocalVelocity.X)) : 0.f;
+
+	const FRotator AimDelta = (ControlRotation - ActorRotation).GetNormalized();
+	AimYaw = AimDelta.Yaw;
+	AimPitch = AimDelta.Pitch;
+}
@@ -0,0 +1,117 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "../PlayerCharacter/PlayerCharacter.h"
+#include "PlayerAnimInstance.generated.h"
+
+/**
+ *  player state for the anim graph. gathered from the owning APlayerCharacter on the game thread (PreUpdate), anything
+ *  derived from it is worked out in Update, which runs on a worker thread along with the graph itself
+ */
+USTRUCT(BlueprintType)
+struct FPlayerAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FPlayerAnimInstanceProxy() : FAnimInstanceProxy() {}
+	FPlayerAnimInstanceProxy(UAnimInstance* Instance) : FAnimInstanceProxy(Instance) {}
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+	/*
+	*  copied from the player
+	*/
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	EMovementStatus MovementStatus = EMovementStatus::EMS_Idle_Standing;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	TEnumAsByte<EPlayerDeathPose> DeathPose = EPD_BackwardPose1;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bAlive = true;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bIdle = true;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bCrouched = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bAiming = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bTurning = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bPushing = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bInCinematic = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bHasWeaponEquipped = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bHasFlashlightEquipped = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	bool bFlashlightOn = false;
+
+	/*
+	*  derived (worker thread)
+	*/
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	float Speed = 0.f;
+
+	// movement direction relative to facing, -180..180
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	float Direction = 0.f;
+
+	// control rotation relative to facing (aim offset input)
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	float AimYaw = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player")
+	float AimPitch = 0.f;
+
+protected:
+
+	FVector Velocity = FVector::ZeroVector;
+	FRotator ActorRotation = FRotator::ZeroRotator;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+};
+
+// proxies are owned by their anim instance, never copied
+template<>
+struct TStructOpsTypeTraits<FPlayerAnimInstanceProxy> : public TStructOpsTypeTraitsBase2<FPlayerAnimInstanceProxy>
+{
+	enum { WithCopy = false };
+};
+
+
+/**
+ *  native base for the player anim BP. the graph reads Proxy.* (thread safe), so the anim BP can have multi-threaded
+ *  animation update enabled and keep its event graph empty
+ */
+UCLASS(Transient, Blueprintable)
+class ESCAPEROOMPROJECT_API UPlayerAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+protected:
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Player", meta = (AllowPrivateAccess = "true"))
+	FPlayerAnimInstanceProxy Proxy;
+
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+	friend struct FPlayerAnimInstanceProxy;
+};
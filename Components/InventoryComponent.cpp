@@ -10,25 +10,30 @@
 UInventoryComponent::UInventoryComponent()
 {
 	Capacity = 9;
+	bValidateSlotAccounting = false;
+	NumStackableSlots = 0;
+	NumNonStackableSlots = 0;
+	ChangeBatchDepth = 0;
+	bFlushScheduled = false;
 }
 
 
-UItem* UInventoryComponent::AddItem(UItem* Item)
+UItem* UInventoryComponent::AddItem(const FItemDescriptor& Descriptor)
 {
-	if (Item)
+	if (Descriptor.ItemClass)
 	{
 		// creating a new instance of the object, now owned by this inventory, and set its properties
-		UItem* NewItem = NewObject<UItem>(GetOwner(), Item->GetClass());
-		NewItem->SetQuantity(Item->GetQuantity());
+		UItem* NewItem = NewObject<UItem>(GetOwner(), Descriptor.ItemClass);
+		NewItem->SetQuantity(Descriptor.Quantity);
 		NewItem->OwningInventory = this;
-		NewItem->bDisableOnPickupSound = Item->bDisableOnPickupSound;
-		NewItem->MaxStackSize = Item->MaxStackSize;
-		NewItem->bStackable = Item->bStackable;
+		NewItem->bDisableOnPickupSound = Descriptor.bDisableOnPickupSound;
 
 		// add it to inventory
-		NewItem->AddedToInventory(this, Item->GetQuantity());
+		NewItem->AddedToInventory(this, Descriptor.Quantity);
 		Items.Add(NewItem);
-		OnInventoryModified.Broadcast();
+		IndexItem(NewItem);
+		ValidateSlotAccounting();
+		MarkItemAdded(NewItem);
 
 		return NewItem;
 	}
@@ -36,10 +41,97 @@ UItem* UInventoryComponent::AddItem(UItem* Item)
 }
 
 
+void UInventoryComponent::IndexItem(UItem* Item)
+{
+	ItemsByClass.FindOrAdd(Item->GetClass()).Add(Item);
+
+	for (const UClass* Class = Item->GetClass(); Class && Class->IsChildOf(UItem::StaticClass()); Class = Class->GetSuperClass())
+	{ ItemsByClassHierarchy.FindOrAdd(Class).Add(Item); }
+
+	(Item->IsStackable() ? NumStackableSlots : NumNonStackableSlots)++;
+	QuantityByClass.FindOrAdd(Item->GetClass()) += Item->GetQuantity();
+}
+
+
+void UInventoryComponent::UnindexItem(UItem* Item)
+{
+	// (order-preserving removes, so lookups keep returning items in the order they were added)
+	if (auto* ClassItems = ItemsByClass.Find(Item->GetClass()))
+	{
+		ClassItems->RemoveSingle(Item);
+		if (ClassItems->Num() == 0) { ItemsByClass.Remove(Item->GetClass()); }
+	}
+
+	(Item->IsStackable() ? NumStackableSlots : NumNonStackableSlots)--;
+	if (int32* ClassQuantity = QuantityByClass.Find(Item->GetClass()))
+	{
+		*ClassQuantity -= Item->GetQuantity();
+		if (*ClassQuantity <= 0) { QuantityByClass.Remove(Item->GetClass()); }
+	}
+
+	for (const UClass* Class = Item->GetClass(); Class && Class->IsChildOf(UItem::StaticClass()); Class = Class->GetSuperClass())
+	{
+		if (TArray<UItem*>* HierarchyItems = ItemsByClassHierarchy.Find(Class))
+		{
+			HierarchyItems->RemoveSingle(Item);
+			if (HierarchyItems->Num() == 0) { ItemsByClassHierarchy.Remove(Class); }
+		}
+	}
+}
+
+
+void UInventoryComponent::OnItemQuantityChanged(UItem* Item, const int32 OldQuantity)
+{
+	// items keep their OwningInventory after being removed; only count ones still held
+	if (!IsHeld(Item))
+	{
+		Item->OnItemModified.Broadcast();
+		return;
+	}
+
+	int32& ClassQuantity = QuantityByClass.FindOrAdd(Item->GetClass());
+	ClassQuantity += Item->GetQuantity() - OldQuantity;
+	if (ClassQuantity <= 0) { QuantityByClass.Remove(Item->GetClass()); }
+
+	ValidateSlotAccounting();
+	MarkItemChanged(Item);
+}
+
+
+void UInventoryComponent::ValidateSlotAccounting() const
+{
+#if !UE_BUILD_SHIPPING
+	if (!bValidateSlotAccounting) { return; }
+
+	int32 ExpectedStackableSlots = 0;
+	int32 ExpectedNonStackableSlots = 0;
+	TMap<const UClass*, int32> ExpectedQuantityByClass;
+
+	for (const UItem* EachItem : Items)
+	{
+		(EachItem->IsStackable() ? ExpectedStackableSlots : ExpectedNonStackableSlots)++;
+		if (EachItem->GetQuantity() > 0) { ExpectedQuantityByClass.FindOrAdd(EachItem->GetClass()) += EachItem->GetQuantity(); }
+	}
+
+	ensureMsgf(NumStackableSlots == ExpectedStackableSlots && NumNonStackableSlots == ExpectedNonStackableSlots,
+		TEXT("%s: slot counters out of sync (stackable %d vs %d, non-stackable %d vs %d)"), *GetName(), NumStackableSlots, ExpectedStackableSlots, NumNonStackableSlots, ExpectedNonStackableSlots);
+
+	ensureMsgf(QuantityByClass.OrderIndependentCompareEqual(ExpectedQuantityByClass), TEXT("%s: per-class quantities out of sync"), *GetName());
+#endif
+}
+
+
+int32 UInventoryComponent::GetItemQuantityByClass(TSubclassOf<class UItem> ItemClass) const
+{
+	const int32* ClassQuantity = QuantityByClass.Find(ItemClass.Get());
+	return ClassQuantity ? *ClassQuantity : 0;
+}
+
+
 void UInventoryComponent::SetCapacity(const int32 NewCapacity)
 {
 	Capacity = NewCapacity;
-	OnInventoryModified.Broadcast();
+	MarkCapacityChanged();
 }
 
 
@@ -56,44 +148,23 @@ bool UInventoryComponent::HasItem(TSubclassOf<class UItem> ItemClass, const int3
 // returns the first item with the same class as the given item
 UItem* UInventoryComponent::FindItem(class UItem* Item) const
 {
-	if (Item)
-	{
-		for (auto& InvItem : Items)
-		{
-			if (InvItem && InvItem->GetClass() == Item->GetClass())
-			{ return InvItem; }
-		}
-	}
-
-	return nullptr;
+	return Item ? FindItemByClass(Item->GetClass()) : nullptr;
 }
 
 
 // returns the first item with the same class as ItemClass
 UItem* UInventoryComponent::FindItemByClass(TSubclassOf<class UItem> ItemClass) const
 {
-	for (auto& InvItem : Items)
-	{
-		if (InvItem && InvItem->GetClass() == ItemClass)
-		{ return InvItem; }
-	}
-
-	return nullptr;
+	const auto* ClassItems = ItemsByClass.Find(ItemClass.Get());
+	return ClassItems ? (*ClassItems)[0] : nullptr;
 }
 
 
 // get all inventory items that are a child of ItemClass. useful for getting all Weapons, all Consumables, etc
 TArray<UItem*> UInventoryComponent::FindItemsByClass(TSubclassOf<class UItem> ItemClass) const
 {
-	TArray<UItem*> ItemsOfClass;
-
-	for (auto& InvItem : Items)
-	{
-		if (InvItem && InvItem->GetClass()->IsChildOf(ItemClass))
-		{ ItemsOfClass.Add(InvItem); }
-	}
-
-	return ItemsOfClass;
+	const TArray<UItem*>* ItemsOfClass = ItemsByClassHierarchy.Find(ItemClass.Get());
+	return ItemsOfClass ? *ItemsOfClass : TArray<UItem*>();
 }
 
 
@@ -119,7 +190,7 @@ int32 UInventoryComponent::ConsumeItem(class UItem* Item, const int32 Quantity)
 		{ RemoveItem(Item); }
 
 		else
-		{ OnInventoryModified.Broadcast(); }
+		{ MarkItemChanged(Item); }
 
 		return RemoveQuantity;
 	}
@@ -132,8 +203,12 @@ bool UInventoryComponent::RemoveItem(UItem* Item)
 {
 	if (Item)
 	{
-		Items.RemoveSingle(Item);
-		OnInventoryModified.Broadcast();
+		if (Items.RemoveSingle(Item) > 0)
+		{
+			UnindexItem(Item);
+			MarkItemRemoved(Item);
+		}
+		ValidateSlotAccounting();
 		return true;
 	}
 
@@ -144,114 +219,118 @@ bool UInventoryComponent::RemoveItem(UItem* Item)
 FItemAddResult UInventoryComponent::TryAddItem(UItem* Item)
 {
 	// validates item's properties
-	if (Item) 
-	{
-		const int32 AddAmount = Item->GetQuantity();
+	if (Item)
+	{ return TryAddItem(FItemDescriptor::FromItem(Item), *Item); }
 
-		if (!Item->bStackable && GetNumInventorySlotsInUse(false) + 1 > GetCapacity())
-		{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryCapacityFullText", "Not enough room to take {ItemName}."), Item->ItemDisplayName)); }
+	return FItemAddResult::AddedNone(-1, LOCTEXT("ErrorMessage", ""));
+}
 
-		// if item is stackable, check if we already have any and if so add to corresponding stack
-		if (Item->bStackable)
-		{
-			// should never go over max stack size
-			ensure(Item->GetQuantity() <= Item->MaxStackSize);
 
-			// if already have some of item and stackable, modify (increment) existing inventory quantity instead of adding entirely new
-			if (UItem* ExistingItem = FindItem(Item))
+// construct item from class and try to add to inventory (i.e., not from a Pickup)
+FItemAddResult UInventoryComponent::TryAddItemFromClass(TSubclassOf<class UItem> ItemClass, const int32 Quantity /*= 1*/)
+{
+	return TryAddItemDescriptor(FItemDescriptor(ItemClass, Quantity, true));
+}
+
+
+FItemAddResult UInventoryComponent::TryAddItemDescriptor(const FItemDescriptor& Descriptor)
+{
+	if (Descriptor.ItemClass == nullptr) { return FItemAddResult::AddedNone(-1, LOCTEXT("ErrorMessage", "")); }
+
+	// the class defaults stand in for the item (quantity follows SetQuantity's rules: clamped if stackable, else the default)
+	const UItem* Defaults = Descriptor.ItemClass->GetDefaultObject<UItem>();
+	FItemDescriptor Normalized = Descriptor;
+	Normalized.Quantity = Defaults->IsStackable() ? FMath::Clamp(Descriptor.Quantity, 0, Defaults->GetMaxStackSize()) : Defaults->GetQuantity();
+
+	return TryAddItem(Normalized, *Defaults);
+}
+
+
+// checks capacity/stacks prior to add, and adds partial if needed; only a new stack creates a UItem
+FItemAddResult UInventoryComponent::TryAddItem(const FItemDescriptor& Descriptor, const UItem& Defaults)
+{
+	const int32 AddAmount = Descriptor.Quantity;
+
+	if (!Defaults.IsStackable() && GetNumInventorySlotsInUse(false) + 1 > GetCapacity())
+	{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryCapacityFullText", "Not enough room to take {ItemName}."), Defaults.GetDisplayName())); }
+
+	// if item is stackable, check if we already have any and if so add to corresponding stack
+	if (Defaults.IsStackable())
+	{
+		// should never go over max stack size
+		ensure(AddAmount <= Defaults.GetMaxStackSize());
+
+		// if already have some of item and stackable, modify (increment) existing inventory quantity instead of adding entirely new
+		if (UItem* ExistingItem = FindItemByClass(Descriptor.ItemClass))
+		{
+			// if room in stack
+			if (ExistingItem->GetQuantity() < ExistingItem->GetMaxStackSize())
 			{
-				// if room in stack
-				if (ExistingItem->GetQuantity() < ExistingItem->MaxStackSize)
+				// determine how much of the item to add
+				const int32 CapacityMaxAddAmount = ExistingItem->GetMaxStackSize() - ExistingItem->GetQuantity();
+				int32 ActualAddAmount = FMath::Min(AddAmount, CapacityMaxAddAmount);
+
+				FText ErrorText = LOCTEXT("InventoryErrorText", "Couldn't add all of the {ItemName}s to your inventory.");
+
+				if (ActualAddAmount < AddAmount)
 				{
-					// determine how much of the item to add
-					const int32 CapacityMaxAddAmount = ExistingItem->MaxStackSize - ExistingItem->GetQuantity();
-					int32 ActualAddAmount = FMath::Min(AddAmount, CapacityMaxAddAmount);
-
-					FText ErrorText = LOCTEXT("InventoryErrorText", "Couldn't add all of the {ItemName}s to your inventory.");
-
-					if (ActualAddAmount < AddAmount)
-					{
-						// not enough capacity in inventory
-						ErrorText = FText::Format(LOCTEXT("InventoryCapacityFullText", "Can't take all of the {ItemName}s - inventory is full."), Item->ItemDisplayName);
-					}
-
-					// we couldn't add *any* of the item to inventory
-					if (ActualAddAmount <= 0)
-					{ return FItemAddResult::AddedNone(AddAmount, LOCTEXT("InventoryErrorText", "Couldn't add item to inventory.")); }
-
-					// success, checks passed: increment item quantity
-					ExistingItem->SetQuantity(ExistingItem->GetQuantity() + ActualAddAmount);
-					
-					// call AddedToInventory for sound effect
-					ExistingItem->AddedToInventory(this, ActualAddAmount);
-					// if we somehow get more of the item than the max stack size, something is wrong with the math
-					ensure(ExistingItem->GetQuantity() <= ExistingItem->MaxStackSize);
-
-					if (ActualAddAmount < AddAmount)
-					{ return FItemAddResult::AddedSome(AddAmount, ActualAddAmount, ErrorText); }
-
-					else
-					{ return FItemAddResult::AddedAll(AddAmount); }
+					// not enough capacity in inventory
+					ErrorText = FText::Format(LOCTEXT("InventoryCapacityFullText", "Can't take all of the {ItemName}s - inventory is full."), Defaults.GetDisplayName());
 				}
 
+				// we couldn't add *any* of the item to inventory
+				if (ActualAddAmount <= 0)
+				{ return FItemAddResult::AddedNone(AddAmount, LOCTEXT("InventoryErrorText", "Couldn't add item to inventory.")); }
+
+				// success, checks passed: increment item quantity
+				ExistingItem->SetQuantity(ExistingItem->GetQuantity() + ActualAddAmount);
+				
+				// call AddedToInventory for sound effect
+				ExistingItem->AddedToInventory(this, ActualAddAmount);
+				// if we somehow get more of the item than the max stack size, something is wrong with the math
+				ensure(ExistingItem->GetQuantity() <= ExistingItem->GetMaxStackSize());
+
+				if (ActualAddAmount < AddAmount)
+				{ return FItemAddResult::AddedSome(AddAmount, ActualAddAmount, ErrorText); }
+
 				else
-				{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryFullStackText", "Can't carry any more {ItemName}s."), Item->ItemDisplayName)); }
+				{ return FItemAddResult::AddedAll(AddAmount); }
 			}
 
 			else
-			{
-				// since we do not have any of this item, and there's no room to start a new stack, add none
-				if (GetNumInventorySlotsInUse(false) + 1 > GetCapacity())
-				{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryCapacityFullText", "Not enough room to take {ItemName}."), Item->ItemDisplayName)); }
-
-				// since we do not have any of this item and there's room to start a stack, add the full stack
-				AddItem(Item);
-				return FItemAddResult::AddedAll(AddAmount);
-			}
+			{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryFullStackText", "Can't carry any more {ItemName}s."), Defaults.GetDisplayName())); }
 		}
 
-		else // item isn't stackable
+		else
 		{
-			// non-stackable items should always have a quantity of 1
-			ensure(Item->GetQuantity() == 1);
+			// since we do not have any of this item, and there's no room to start a new stack, add none
+			if (GetNumInventorySlotsInUse(false) + 1 > GetCapacity())
+			{ return FItemAddResult::AddedNone(AddAmount, FText::Format(LOCTEXT("InventoryCapacityFullText", "Not enough room to take {ItemName}."), Defaults.GetDisplayName())); }
 
-			AddItem(Item);
+			// since we do not have any of this item and there's room to start a stack, add the full stack
+			AddItem(Descriptor);
 			return FItemAddResult::AddedAll(AddAmount);
 		}
 	}
 
-	return FItemAddResult::AddedNone(-1, LOCTEXT("ErrorMessage", ""));
-}
-
+	else // item isn't stackable
+	{
+		// non-stackable items should always have a quantity of 1
+		ensure(AddAmount == 1);
 
-// construct item from class and try to add to inventory (i.e., not from a Pickup)
-FItemAddResult UInventoryComponent::TryAddItemFromClass(TSubclassOf<class UItem> ItemClass, const int32 Quantity /*= 1*/)
-{
-	UItem* Item = NewObject<UItem>(GetOwner(), ItemClass);
-	Item->SetQuantity(Quantity);
-	Item->bDisableOnPickupSound = true;
-	return TryAddItem(Item);
+		AddItem(Descriptor);
+		return FItemAddResult::AddedAll(AddAmount);
+	}
 }
 
 
-int32 UInventoryComponent::GetNumInventorySlotsInUse(bool bDebug)
+int32 UInventoryComponent::GetNumInventorySlotsInUse(bool bDebug) const
 {
-	int32 NumSlotsInUse = 0;
-	TArray<UItem*> UniqueStackableItems;
-	for (UItem* EachItem : Items)
-	{
-		if (EachItem->bStackable)
-		{ UniqueStackableItems.AddUnique(EachItem); }
-
-		else 
-		{ NumSlotsInUse ++; }
-	}
-	
-	NumSlotsInUse += UniqueStackableItems.Num();
+	const int32 NumSlotsInUse = NumStackableSlots + NumNonStackableSlots;
 
 	if (bDebug)
 	{
-		FString StackableCountStr = FString::FromInt(UniqueStackableItems.Num());
+		FString StackableCountStr = FString::FromInt(NumStackableSlots);
 		printFString("stackable count: %s", *StackableCountStr);
 
 		FString TotalCountStr = FString::FromInt(NumSlotsInUse);
@@ -265,4 +344,101 @@ int32 UInventoryComponent::GetNumInventorySlotsInUse(bool bDebug)
 }
 
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+void UInventoryComponent::BeginChangeBatch()
+{
+	++ChangeBatchDepth;
+}
+
+
+void UInventoryComponent::EndChangeBatch()
+{
+	if (!ensure(ChangeBatchDepth > 0)) { return; }
+
+	if (--ChangeBatchDepth == 0)
+	{ ScheduleFlush(); }
+}
+
+
+void UInventoryComponent::MarkItemAdded(UItem* Item)
+{
+	// removed + re-added within the same delta: it's just changed
+	if (PendingDelta.RemovedItems.RemoveSingleSwap(Item) > 0)
+	{ PendingDelta.ChangedItems.AddUnique(Item); }
+	else
+	{ PendingDelta.AddedItems.AddUnique(Item); }
+
+	ScheduleFlush();
+}
+
+
+void UInventoryComponent::MarkItemRemoved(UItem* Item)
+{
+	PendingDelta.ChangedItems.RemoveSingleSwap(Item);
+
+	// added + removed within the same delta: nothing for listeners to see
+	if (PendingDelta.AddedItems.RemoveSingleSwap(Item) == 0)
+	{ PendingDelta.RemovedItems.AddUnique(Item); }
+
+	ScheduleFlush();
+}
+
+
+void UInventoryComponent::MarkItemChanged(UItem* Item)
+{
+	if (Item == nullptr) { return; }
+
+	// not (or no longer) ours to batch
+	if (!IsHeld(Item))
+	{
+		Item->OnItemModified.Broadcast();
+		return;
+	}
+
+	if (!PendingDelta.AddedItems.Contains(Item))
+	{ PendingDelta.ChangedItems.AddUnique(Item); }
+
+	ScheduleFlush();
+}
+
+
+void UInventoryComponent::MarkCapacityChanged()
+{
+	PendingDelta.bCapacityChanged = true;
+	ScheduleFlush();
+}
+
+
+void UInventoryComponent::ScheduleFlush()
+{
+	if (bFlushScheduled || ChangeBatchDepth > 0) { return; }
+
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		FlushChanges();
+		return;
+	}
+
+	bFlushScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(this, &UInventoryComponent::FlushChanges);
+}
+
+
+// one notification for everything collected since the last one
+void UInventoryComponent::FlushChanges()
+{
+	bFlushScheduled = false;
+	if (ChangeBatchDepth > 0 || PendingDelta.IsEmpty()) { return; }
+
+	// take the delta first: listeners may modify the inventory again (those changes go out with the next flush)
+	FInventoryDelta Delta = MoveTemp(PendingDelta);
+	PendingDelta.Reset();
+
+	for (UItem* ChangedItem : Delta.ChangedItems)
+	{ ChangedItem->OnItemModified.Broadcast(); }
+
+	OnInventoryChanged.Broadcast(Delta);
+	OnInventoryModified.Broadcast();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -7,7 +7,7 @@
 #include "../Items/Item.h"
 #include "InventoryComponent.generated.h"
 
-// called when the inventory is changed and the UI needs to be updated accordingly
+// called when the inventory is changed and the UI needs to be updated accordingly (at most once per frame)
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryModified);
 
 
@@ -82,6 +82,68 @@ public:
 	}
 };
 
+// what to add to an inventory, by value: a UItem is only created if the add starts a new stack
+USTRUCT(BlueprintType)
+struct FItemDescriptor
+{
+	GENERATED_BODY()
+
+public:
+
+	FItemDescriptor() : Quantity(1), bDisableOnPickupSound(false) {};
+	FItemDescriptor(TSubclassOf<class UItem> InItemClass, int32 InQuantity, bool bInDisableOnPickupSound = false) : ItemClass(InItemClass), Quantity(InQuantity), bDisableOnPickupSound(bInDisableOnPickupSound) {};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Descriptor")
+	TSubclassOf<class UItem> ItemClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Descriptor")
+	int32 Quantity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Descriptor")
+	bool bDisableOnPickupSound;
+
+	// describes an existing item instance (e.g., a pickup's)
+	static FItemDescriptor FromItem(const UItem* Item)
+	{ return FItemDescriptor(Item->GetClass(), Item->GetQuantity(), Item->bDisableOnPickupSound); }
+};
+
+
+// everything that changed in an inventory since its last change notification (each item is one slot)
+USTRUCT(BlueprintType)
+struct FInventoryDelta
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory Delta")
+	TArray<UItem*> AddedItems;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory Delta")
+	TArray<UItem*> RemovedItems;
+
+	// still held, but quantity (or e.g. equipped state) changed; never also in AddedItems
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory Delta")
+	TArray<UItem*> ChangedItems;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory Delta")
+	bool bCapacityChanged = false;
+
+	FORCEINLINE bool IsEmpty() const { return AddedItems.Num() == 0 && RemovedItems.Num() == 0 && ChangedItems.Num() == 0 && !bCapacityChanged; }
+
+	void Reset()
+	{
+		AddedItems.Reset();
+		RemovedItems.Reset();
+		ChangedItems.Reset();
+		bCapacityChanged = false;
+	}
+};
+
+// as FOnInventoryModified, with what changed
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, const FInventoryDelta&, Delta);
+
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ESCAPEROOMPROJECT_API UInventoryComponent : public UActorComponent
 {
@@ -95,6 +157,10 @@ public:
 
 	UPROPERTY(BlueprintAssignable)
 	FOnInventoryModified OnInventoryModified;
+
+	// broadcast right before OnInventoryModified, with everything that changed since the last notification
+	UPROPERTY(BlueprintAssignable)
+	FOnInventoryChanged OnInventoryChanged;
 	
 	// for tracking an added item's pickup ID
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
@@ -121,9 +187,64 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory", meta = (ClampMin = 0, ClampMax = 100))
 	int32 Capacity;
 
+	// cross-check the incrementally maintained slot/quantity counters against a full recompute after every change (non-shipping)
+	UPROPERTY(EditAnywhere, Category = "Inventory|Debug")
+	bool bValidateSlotAccounting;
+
 private:
 
-	UItem* AddItem(class UItem* Item);
+	// creates the new stack's UItem (static data, stacking rules included, comes from the class's item definition)
+	UItem* AddItem(const FItemDescriptor& Descriptor);
+
+	FItemAddResult TryAddItem(const FItemDescriptor& Descriptor, const UItem& Defaults);
+
+	// Items by exact class, in the order they were added (the first is what FindItemByClass returns)
+	TMap<const UClass*, TArray<UItem*, TInlineAllocator<1>>> ItemsByClass;
+
+	// Items by every item class they are an instance of (their own class + each parent up to UItem), for FindItemsByClass
+	TMap<const UClass*, TArray<UItem*>> ItemsByClassHierarchy;
+
+	// derived from Items, maintained as items are added/removed/change quantity: each stackable item is a stack
+	// taking one slot, each non-stackable item takes one slot
+	int32 NumStackableSlots;
+	int32 NumNonStackableSlots;
+
+	// total quantity held per exact item class
+	TMap<const UClass*, int32> QuantityByClass;
+
+	// keep the indices + counters in step with Items (call on every add/remove)
+	void IndexItem(UItem* Item);
+	void UnindexItem(UItem* Item);
+
+	// called by UItem::SetQuantity
+	void OnItemQuantityChanged(UItem* Item, const int32 OldQuantity);
+
+	// recompute everything from Items + compare (bValidateSlotAccounting)
+	void ValidateSlotAccounting() const;
+
+	FORCEINLINE bool IsHeld(const UItem* Item) const
+	{
+		const auto* ClassItems = ItemsByClass.Find(Item->GetClass());
+		return ClassItems && ClassItems->Contains(Item);
+	}
+
+	/*
+	*  change notifications: changes are collected into PendingDelta and broadcast together on the next tick
+	*  (or once the outermost change batch ends)
+	*/
+
+	UPROPERTY(Transient)
+	FInventoryDelta PendingDelta;
+
+	int32 ChangeBatchDepth;
+	bool bFlushScheduled;
+
+	void MarkItemAdded(UItem* Item);
+	void MarkItemRemoved(UItem* Item);
+	void MarkCapacityChanged();
+
+	void ScheduleFlush();
+	void FlushChanges();
 
 public:	
 
@@ -169,5 +290,40 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	FItemAddResult TryAddItemFromClass(TSubclassOf<class UItem> ItemClass, const int32 Quantity = 1);
 
-	int32 GetNumInventorySlotsInUse(bool bDebug);
+	// add by descriptor; merging into an existing stack allocates nothing
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	FItemAddResult TryAddItemDescriptor(const FItemDescriptor& Descriptor);
+
+	// total quantity of items of exactly ItemClass (across all stacks)
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetItemQuantityByClass(TSubclassOf<class UItem> ItemClass) const;
+
+	int32 GetNumInventorySlotsInUse(bool bDebug) const;
+
+	// hold change notifications until the matching EndChangeBatch (nestable), so bulk changes (e.g., loading a save)
+	// reach the UI as a single refresh
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void BeginChangeBatch();
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void EndChangeBatch();
+
+	// flag a held item as modified (e.g., after using it) so it is refreshed with the next change notification
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void MarkItemChanged(UItem* Item);
+};
+
+
+// batches an inventory's change notifications for the lifetime of the scope
+struct FInventoryChangeBatchScope
+{
+	explicit FInventoryChangeBatchScope(UInventoryComponent* InInventory) : Inventory(InInventory)
+	{ if (Inventory) { Inventory->BeginChangeBatch(); } }
+
+	~FInventoryChangeBatchScope()
+	{ if (Inventory) { Inventory->EndChangeBatch(); } }
+
+private:
+
+	UInventoryComponent* Inventory;
 };
@@ -0,0 +1,178 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Effects/AudioVoiceSubsystem.h"
+#include "../EscapeRoomProject.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Audio Voices"), STAT_ActiveAudioVoices, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Voices Stolen"), STAT_AudioVoicesStolen, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Voices Dropped"), STAT_AudioVoicesDropped, STATGROUP_Effects);
+
+
+// sets default values
+UAudioVoiceSubsystem::UAudioVoiceSubsystem()
+{
+	MaxVoices = 24;
+
+	VoiceOwner = nullptr;
+	NumActiveVoices = 0;
+	NextSerial = 1;
+}
+
+
+UAudioComponent* UAudioVoiceSubsystem::CreateVoiceComponent()
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) { return nullptr; }
+
+	if (VoiceOwner == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		VoiceOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (VoiceOwner == nullptr) { return nullptr; }
+	}
+
+	UAudioComponent* Component = NewObject<UAudioComponent>(VoiceOwner);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->bStopWhenOwnerDestroyed = false;
+	Component->OnAudioFinishedNative.AddUObject(this, &UAudioVoiceSubsystem::OnVoiceFinished);
+	Component->RegisterComponent();
+
+	return Component;
+}
+
+
+int32 UAudioVoiceSubsystem::FindVoiceFor(EAudioVoicePriority Priority)
+{
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		if (!Voices[Index].bInUse) { return Index; }
+	}
+
+	if (Voices.Num() < MaxVoices)
+	{
+		FAudioVoice& Voice = Voices.AddDefaulted_GetRef();
+		Voice.Component = CreateVoiceComponent();
+		return Voice.Component ? Voices.Num() - 1 : INDEX_NONE;
+	}
+
+	// budget full: steal the lowest priority voice (oldest first among equals), if it doesn't outrank this request
+	int32 StealIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		const FAudioVoice& Voice = Voices[Index];
+		if (Voice.Priority > Priority) { continue; }
+
+		if (StealIndex == INDEX_NONE || Voice.Priority < Voices[StealIndex].Priority
+			|| (Voice.Priority == Voices[StealIndex].Priority && Voice.Serial < Voices[StealIndex].Serial))
+		{ StealIndex = Index; }
+	}
+
+	return StealIndex;
+}
+
+
+FAudioVoiceHandle UAudioVoiceSubsystem::PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachTo, EAudioVoicePriority Priority, float VolumeMultiplier)
+{
+	FAudioVoiceHandle Handle;
+	if (Sound == nullptr || AttachTo == nullptr) { return Handle; }
+
+	const int32 Index = FindVoiceFor(Priority);
+	if (Index == INDEX_NONE)
+	{
+		INC_DWORD_STAT(STAT_AudioVoicesDropped);
+		return Handle;
+	}
+
+	if (Voices[Index].bInUse)
+	{
+		ReleaseVoice(Index);
+		INC_DWORD_STAT(STAT_AudioVoicesStolen);
+	}
+
+	FAudioVoice& Voice = Voices[Index];
+	Voice.Priority = Priority;
+	Voice.Serial = NextSerial++;
+	Voice.bInUse = true;
+	++NumActiveVoices;
+	INC_DWORD_STAT(STAT_ActiveAudioVoices);
+
+	UAudioComponent* Component = Voice.Component;
+	Component->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	Component->SetSound(Sound);
+	Component->SetVolumeMultiplier(VolumeMultiplier);
+	Component->Play();
+
+	Handle.Index = Index;
+	Handle.Serial = Voice.Serial;
+	return Handle;
+}
+
+
+UAudioComponent* UAudioVoiceSubsystem::GetVoiceComponent(const FAudioVoiceHandle& Handle) const
+{
+	if (!Voices.IsValidIndex(Handle.Index)) { return nullptr; }
+
+	const FAudioVoice& Voice = Voices[Handle.Index];
+	return (Voice.bInUse && Voice.Serial == Handle.Serial) ? Voice.Component : nullptr;
+}
+
+
+bool UAudioVoiceSubsystem::IsVoicePlaying(const FAudioVoiceHandle& Handle) const
+{
+	const UAudioComponent* Component = GetVoiceComponent(Handle);
+	return Component && Component->IsPlaying();
+}
+
+
+void UAudioVoiceSubsystem::StopVoice(const FAudioVoiceHandle& Handle)
+{
+	if (GetVoiceComponent(Handle) != nullptr)
+	{ ReleaseVoice(Handle.Index); }
+}
+
+
+void UAudioVoiceSubsystem::StopVoicesOn(AActor* Actor)
+{
+	if (Actor == nullptr) { return; }
+
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		const FAudioVoice& Voice = Voices[Index];
+		if (!Voice.bInUse || Voice.Component == nullptr) { continue; }
+
+		const USceneComponent* Parent = Voice.Component->GetAttachParent();
+		if (Parent && Parent->GetOwner() == Actor)
+		{ ReleaseVoice(Index); }
+	}
+}
+
+
+void UAudioVoiceSubsystem::ReleaseVoice(int32 Index)
+{
+	FAudioVoice& Voice = Voices[Index];
+	if (!Voice.bInUse) { return; }
+
+	// mark free first; Stop() below re-enters through OnVoiceFinished
+	Voice.bInUse = false;
+	--NumActiveVoices;
+	DEC_DWORD_STAT(STAT_ActiveAudioVoices);
+
+	if (Voice.Component)
+	{
+		Voice.Component->Stop();
+		Voice.Component->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+}
+
+
+void UAudioVoiceSubsystem::OnVoiceFinished(UAudioComponent* Component)
+{
+	const int32 Index = Voices.IndexOfByPredicate([Component](const FAudioVoice& Voice) { return Voice.Component == Component; });
+	if (Index != INDEX_NONE)
+	{ ReleaseVoice(Index); }
+}
@@ -0,0 +1,114 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AudioVoiceSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+// who wins when the voice budget is full; a request may steal a voice of equal or lower priority
+UENUM(BlueprintType)
+enum class EAudioVoicePriority : uint8
+{
+	AVP_Low			UMETA(DisplayName = "Low"),			// idle chatter
+	AVP_Medium		UMETA(DisplayName = "Medium"),		// chasing cues
+	AVP_High		UMETA(DisplayName = "High"),		// hurt / death cues
+	AVP_Critical	UMETA(DisplayName = "Critical"),	// the player's own weapon
+
+	AVP_MAX			UMETA(DisplayName = "DefaultMAX")
+};
+
+
+// refers to one playback on a pooled voice; goes stale (resolves to nothing) once that voice finishes or is stolen
+struct FAudioVoiceHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	FORCEINLINE bool IsSet() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Reset() { Index = INDEX_NONE; Serial = 0; }
+};
+
+
+// one pooled audio component
+USTRUCT()
+struct FAudioVoice
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UAudioComponent* Component = nullptr;
+
+	EAudioVoicePriority Priority = EAudioVoicePriority::AVP_Low;
+
+	// bumped on every new playback, so stale handles don't resolve
+	uint32 Serial = 0;
+
+	bool bInUse = false;
+};
+
+
+/**
+ *  a fixed budget of pooled audio components for short attached one-shots (enemy speech, weapon SFX).
+ *  when every voice is busy, the oldest lowest-priority voice is stolen if the new sound's priority is at least as high;
+ *  otherwise the new sound is dropped. callers hold an FAudioVoiceHandle rather than the component itself
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UAudioVoiceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UAudioVoiceSubsystem();
+
+	// play a sound attached to a component; returns an unset handle if the budget had no room for it
+	FAudioVoiceHandle PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachTo, EAudioVoicePriority Priority, float VolumeMultiplier = 1.f);
+
+	// the component still playing this handle's sound (null once finished / stolen)
+	UAudioComponent* GetVoiceComponent(const FAudioVoiceHandle& Handle) const;
+
+	bool IsVoicePlaying(const FAudioVoiceHandle& Handle) const;
+
+	void StopVoice(const FAudioVoiceHandle& Handle);
+
+	// stop every voice attached to this actor (e.g., an enemy going back to its pool)
+	UFUNCTION(BlueprintCallable, Category = "Audio Voices")
+	void StopVoicesOn(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "Audio Voices")
+	FORCEINLINE int32 GetNumActiveVoices() const { return NumActiveVoices; }
+
+	/*
+	*  tuning
+	*/
+
+	// most pooled sounds playing at once
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio Voices")
+	int32 MaxVoices;
+
+protected:
+
+	UPROPERTY(Transient)
+	TArray<FAudioVoice> Voices;
+
+	// owns the pooled components (they attach to whatever is speaking)
+	UPROPERTY(Transient)
+	AActor* VoiceOwner;
+
+	int32 NumActiveVoices;
+
+	uint32 NextSerial;
+
+	// free voice, else grow the pool, else steal; INDEX_NONE if nothing can be stolen
+	int32 FindVoiceFor(EAudioVoicePriority Priority);
+
+	UAudioComponent* CreateVoiceComponent();
+
+	void ReleaseVoice(int32 Index);
+
+	void OnVoiceFinished(UAudioComponent* Component);
+};
@@ -0,0 +1,239 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Effects/DecalPoolSubsystem.h"
+#include "../EscapeRoomProject.h"
+#include "Components/DecalComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Decals"), STAT_ActiveDecals, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decals Recycled"), STAT_DecalsRecycled, STATGROUP_Effects);
+
+
+// sets default values
+UDecalPoolSubsystem::UDecalPoolSubsystem()
+{
+	MaxDecals = 128;
+	DefaultSurfaceCap = 64;
+	ExpireCheckInterval = 1.f;
+
+	DecalOwner = nullptr;
+	NumActiveDecals = 0;
+	FMemory::Memzero(SurfaceCounts);
+
+	for (int32 Surface = 0; Surface < SurfaceType_Max; ++Surface)
+	{
+		SurfaceOldest[Surface] = INDEX_NONE;
+		SurfaceNewest[Surface] = INDEX_NONE;
+	}
+
+	OldestInUse = INDEX_NONE;
+	NewestInUse = INDEX_NONE;
+}
+
+
+void UDecalPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	Slots.Reserve(MaxDecals);
+	FreeSlots.Reserve(MaxDecals);
+
+	if (ExpireCheckInterval > 0.f)
+	{ InWorld.GetTimerManager().SetTimer(ExpireTimer, this, &UDecalPoolSubsystem::ReleaseExpiredDecals, ExpireCheckInterval, true); }
+}
+
+
+void UDecalPoolSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{ World->GetTimerManager().ClearTimer(ExpireTimer); }
+
+	Super::Deinitialize();
+}
+
+
+int32 UDecalPoolSubsystem::GetSurfaceCap(EPhysicalSurface Surface) const
+{
+	const int32* Cap = SurfaceCaps.Find(Surface);
+	return Cap ? *Cap : DefaultSurfaceCap;
+}
+
+
+// append a slot at the newest end of one of the spawn-order FIFOs
+static void LinkNewest(TArray<FPooledDecal>& Slots, int32 Index, int32 FPooledDecal::* Prev, int32 FPooledDecal::* Next, int32& Oldest, int32& Newest)
+{
+	Slots[Index].*Prev = Newest;
+	Slots[Index].*Next = INDEX_NONE;
+
+	if (Newest != INDEX_NONE) { Slots[Newest].*Next = Index; }
+	else { Oldest = Index; }
+
+	Newest = Index;
+}
+
+
+static void Unlink(TArray<FPooledDecal>& Slots, int32 Index, int32 FPooledDecal::* Prev, int32 FPooledDecal::* Next, int32& Oldest, int32& Newest)
+{
+	FPooledDecal& Slot = Slots[Index];
+
+	if (Slot.*Prev != INDEX_NONE) { Slots[Slot.*Prev].*Next = Slot.*Next; }
+	else { Oldest = Slot.*Next; }
+
+	if (Slot.*Next != INDEX_NONE) { Slots[Slot.*Next].*Prev = Slot.*Prev; }
+	else { Newest = Slot.*Prev; }
+
+	Slot.*Prev = INDEX_NONE;
+	Slot.*Next = INDEX_NONE;
+}
+
+
+int32 UDecalPoolSubsystem::AcquireSlot(EPhysicalSurface Surface)
+{
+	// this surface is full: recycle its oldest
+	int32 RecycleIndex = SurfaceCounts[Surface] >= GetSurfaceCap(Surface) ? SurfaceOldest[Surface] : INDEX_NONE;
+
+	if (RecycleIndex == INDEX_NONE)
+	{
+		// a free slot
+		if (FreeSlots.Num() > 0) { return FreeSlots.Pop(false); }
+
+		// ring not yet at capacity: grow it
+		if (Slots.Num() < MaxDecals)
+		{
+			UDecalComponent* Decal = CreateDecalComponent();
+			if (Decal == nullptr) { return INDEX_NONE; }
+
+			Slots.AddDefaulted_GetRef().Decal = Decal;
+			return Slots.Num() - 1;
+		}
+
+		// full: recycle the oldest overall
+		RecycleIndex = OldestInUse;
+	}
+
+	if (RecycleIndex != INDEX_NONE)
+	{
+		DeactivateSlot(RecycleIndex);
+		INC_DWORD_STAT(STAT_DecalsRecycled);
+	}
+
+	return RecycleIndex;
+}
+
+
+UDecalComponent* UDecalPoolSubsystem::CreateDecalComponent()
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) { return nullptr; }
+
+	if (DecalOwner == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		DecalOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (DecalOwner == nullptr) { return nullptr; }
+	}
+
+	UDecalComponent* Decal = NewObject<UDecalComponent>(DecalOwner);
+	Decal->SetFadeScreenSize(0.f);
+	Decal->SetVisibility(false);
+	Decal->RegisterComponent();
+
+	return Decal;
+}
+
+
+UDecalComponent* UDecalPoolSubsystem::SpawnDecalAtHit(UMaterialInterface* DecalMaterial, FVector DecalSize, const FHitResult& Hit, FRotator Rotation, float LifeSpan)
+{
+	if (DecalMaterial == nullptr || MaxDecals <= 0) { return nullptr; }
+
+	const EPhysicalSurface Surface = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+
+	const int32 Index = AcquireSlot(Surface);
+	if (Index == INDEX_NONE) { return nullptr; }
+
+	FPooledDecal& Slot = Slots[Index];
+	UDecalComponent* Decal = Slot.Decal;
+
+	Decal->DecalSize = DecalSize;
+	Decal->SetDecalMaterial(DecalMaterial);
+	Decal->SetWorldLocationAndRotation(Hit.ImpactPoint, Rotation);
+
+	// follow the hit component (+ bone, for skeletal meshes)
+	if (USceneComponent* HitComponent = Hit.GetComponent())
+	{ Decal->AttachToComponent(HitComponent, FAttachmentTransformRules::KeepWorldTransform, Hit.BoneName); }
+
+	Decal->SetVisibility(true);
+
+	Slot.Surface = Surface;
+	Slot.ExpireTime = LifeSpan > 0.f ? GetWorld()->GetTimeSeconds() + LifeSpan : 0.0;
+	Slot.bInUse = true;
+
+	LinkNewest(Slots, Index, &FPooledDecal::PrevSameSurface, &FPooledDecal::NextSameSurface, SurfaceOldest[Surface], SurfaceNewest[Surface]);
+	LinkNewest(Slots, Index, &FPooledDecal::PrevInUse, &FPooledDecal::NextInUse, OldestInUse, NewestInUse);
+
+	++SurfaceCounts[Surface];
+	++NumActiveDecals;
+	INC_DWORD_STAT(STAT_ActiveDecals);
+
+	return Decal;
+}
+
+
+void UDecalPoolSubsystem::DeactivateSlot(int32 Index)
+{
+	FPooledDecal& Slot = Slots[Index];
+
+	if (Slot.Decal)
+	{
+		Slot.Decal->SetVisibility(false);
+		Slot.Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Unlink(Slots, Index, &FPooledDecal::PrevSameSurface, &FPooledDecal::NextSameSurface, SurfaceOldest[Slot.Surface], SurfaceNewest[Slot.Surface]);
+	Unlink(Slots, Index, &FPooledDecal::PrevInUse, &FPooledDecal::NextInUse, OldestInUse, NewestInUse);
+
+	Slot.bInUse = false;
+	--SurfaceCounts[Slot.Surface];
+	--NumActiveDecals;
+	DEC_DWORD_STAT(STAT_ActiveDecals);
+}
+
+
+void UDecalPoolSubsystem::ReleaseSlot(int32 Index)
+{
+	if (!Slots[Index].bInUse) { return; }
+
+	DeactivateSlot(Index);
+	FreeSlots.Push(Index);
+}
+
+
+void UDecalPoolSubsystem::ReleaseDecalsOn(AActor* Actor)
+{
+	if (Actor == nullptr) { return; }
+
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		const FPooledDecal& Slot = Slots[Index];
+		if (!Slot.bInUse || Slot.Decal == nullptr) { continue; }
+
+		const USceneComponent* Parent = Slot.Decal->GetAttachParent();
+		if (Parent && Parent->GetOwner() == Actor)
+		{ ReleaseSlot(Index); }
+	}
+}
+
+
+void UDecalPoolSubsystem::ReleaseExpiredDecals()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		const FPooledDecal& Slot = Slots[Index];
+		if (Slot.bInUse && Slot.ExpireTime > 0.0 && Slot.ExpireTime <= CurrentTime)
+		{ ReleaseSlot(Index); }
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "DecalPoolSubsystem.generated.h"
+
+class UDecalComponent;
+class UMaterialInterface;
+
+// one slot of the decal ring
+USTRUCT()
+struct FPooledDecal
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UDecalComponent* Decal = nullptr;
+
+	TEnumAsByte<EPhysicalSurface> Surface = SurfaceType_Default;
+
+	// neighbours in spawn order among the decals in use, of the same surface and overall (INDEX_NONE at either end)
+	int32 PrevSameSurface = INDEX_NONE;
+	int32 NextSameSurface = INDEX_NONE;
+	int32 PrevInUse = INDEX_NONE;
+	int32 NextInUse = INDEX_NONE;
+
+	// 0 = never expires
+	double ExpireTime = 0.0;
+
+	bool bInUse = false;
+};
+
+
+/**
+ *  fixed-capacity ring of reusable decal components (bullet holes, blood). once the ring is full (or a surface type
+ *  reaches its cap), the oldest decal is recycled instead of a new component being created. decals can attach to
+ *  a skeletal bone, so hits on enemies follow the body; call ReleaseDecalsOn when that actor is recycled / removed
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UDecalPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UDecalPoolSubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// place a decal at a hit, attached to the hit component (+ bone); surface type is taken from the hit's physical material
+	UFUNCTION(BlueprintCallable, Category = "Decal Pool")
+	UDecalComponent* SpawnDecalAtHit(UMaterialInterface* DecalMaterial, FVector DecalSize, const FHitResult& Hit, FRotator Rotation, float LifeSpan = 0.f);
+
+	// hide + detach every decal attached to this actor (e.g., an enemy going back to its pool)
+	UFUNCTION(BlueprintCallable, Category = "Decal Pool")
+	void ReleaseDecalsOn(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "Decal Pool")
+	FORCEINLINE int32 GetNumActiveDecals() const { return NumActiveDecals; }
+
+	/*
+	*  tuning
+	*/
+
+	// size of the ring; the most decals ever alive at once
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Decal Pool")
+	int32 MaxDecals;
+
+	// most decals per surface type (surfaces not listed use DefaultSurfaceCap)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Decal Pool")
+	TMap<TEnumAsByte<EPhysicalSurface>, int32> SurfaceCaps;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Decal Pool")
+	int32 DefaultSurfaceCap;
+
+	// how often expired decals are hidden
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Decal Pool")
+	float ExpireCheckInterval;
+
+protected:
+
+	UPROPERTY(Transient)
+	TArray<FPooledDecal> Slots;
+
+	// owns the pooled components (decals are attached to whatever they hit, not to this)
+	UPROPERTY(Transient)
+	AActor* DecalOwner;
+
+	// decals in use, per surface type
+	int32 SurfaceCounts[SurfaceType_Max];
+
+	// spawn-order FIFOs of the slots in use (linked through the slots): per surface type and overall. the oldest is
+	// always at the head, so recycling never has to search
+	int32 SurfaceOldest[SurfaceType_Max];
+	int32 SurfaceNewest[SurfaceType_Max];
+	int32 OldestInUse;
+	int32 NewestInUse;
+
+	// released slots, ready for reuse
+	TArray<int32> FreeSlots;
+
+	int32 NumActiveDecals;
+
+	FTimerHandle ExpireTimer;
+
+	int32 GetSurfaceCap(EPhysicalSurface Surface) const;
+
+	// a slot ready for a new decal of this surface: the oldest of this surface (if at its cap), else a free one, else a
+	// new one (ring not full yet), else the oldest overall. constant time
+	int32 AcquireSlot(EPhysicalSurface Surface);
+
+	UDecalComponent* CreateDecalComponent();
+
+	// hide + detach a slot's decal and take it out of the FIFOs (not yet back on the free list)
+	void DeactivateSlot(int32 Index);
+
+	void ReleaseSlot(int32 Index);
+
+	void ReleaseExpiredDecals();
+};
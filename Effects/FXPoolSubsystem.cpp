@@ -0,0 +1,187 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Effects/FXPoolSubsystem.h"
+#include "../EscapeRoomProject.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Pooled FX"), STAT_ActivePooledFX, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawned"), STAT_FXSpawned, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Reused"), STAT_FXReused, STATGROUP_Effects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Rejected"), STAT_FXRejected, STATGROUP_Effects);
+
+
+// sets default values
+UFXPoolSubsystem::UFXPoolSubsystem()
+{
+	FXOwner = nullptr;
+	NumSpawned = 0;
+	NumReused = 0;
+	NumRejected = 0;
+	MaxPersistentFX = 24;
+	NextPersistentIndex = 0;
+}
+
+
+void UFXPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (const FFXSystemBudget& Budget : SystemBudgets)
+	{ PrewarmSystem(Budget.System); }
+}
+
+
+const FFXSystemBudget& UFXPoolSubsystem::GetBudget(const UNiagaraSystem* System) const
+{
+	const FFXSystemBudget* Budget = SystemBudgets.FindByPredicate([System](const FFXSystemBudget& Entry) { return Entry.System == System; });
+	return Budget ? *Budget : DefaultBudget;
+}
+
+
+bool UFXPoolSubsystem::IsCulled(const FVector& Location, float CullDistance) const
+{
+	if (CullDistance <= 0.f) { return false; }
+
+	const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0);
+	if (CameraManager == nullptr) { return false; }
+
+	return FVector::DistSquared(CameraManager->GetCameraLocation(), Location) > FMath::Square(CullDistance);
+}
+
+
+UNiagaraComponent* UFXPoolSubsystem::CreateComponent(UNiagaraSystem* System)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) { return nullptr; }
+
+	if (FXOwner == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		FXOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (FXOwner == nullptr) { return nullptr; }
+	}
+
+	UNiagaraComponent* Component = NewObject<UNiagaraComponent>(FXOwner);
+	Component->SetAsset(System);
+	Component->SetAutoActivate(false);
+	Component->SetAutoDestroy(false);
+	Component->OnSystemFinished.AddDynamic(this, &UFXPoolSubsystem::OnSystemFinished);
+	Component->RegisterComponent();
+
+	return Component;
+}
+
+
+void UFXPoolSubsystem::PrewarmSystem(UNiagaraSystem* System)
+{
+	if (System == nullptr) { return; }
+
+	FFXSystemPool& Pool = Pools.FindOrAdd(System);
+	const int32 PrewarmCount = GetBudget(System).PrewarmCount;
+
+	while (Pool.FreeComponents.Num() + Pool.ActiveComponents.Num() < PrewarmCount)
+	{
+		UNiagaraComponent* Component = CreateComponent(System);
+		if (Component == nullptr) { return; }
+
+		Pool.FreeComponents.Add(Component);
+	}
+}
+
+
+UNiagaraComponent* UFXPoolSubsystem::SpawnSystemAtLocation(UNiagaraSystem* System, FVector Location, FRotator Rotation)
+{
+	if (System == nullptr) { return nullptr; }
+
+	// a looping system never finishes, so it would hold its slot in the per-system budget forever
+	if (System->IsLooping())
+	{ return SpawnPersistentSystemAtLocation(System, Location, Rotation); }
+
+	const FFXSystemBudget& Budget = GetBudget(System);
+	FFXSystemPool& Pool = Pools.FindOrAdd(System);
+
+	// too far away to matter, or this system already has enough instances playing
+	if (IsCulled(Location, Budget.CullDistance) || Pool.ActiveComponents.Num() >= Budget.MaxActive)
+	{
+		++NumRejected;
+		INC_DWORD_STAT(STAT_FXRejected);
+		return nullptr;
+	}
+
+	UNiagaraComponent* Component = nullptr;
+	if (Pool.FreeComponents.Num() > 0)
+	{
+		Component = Pool.FreeComponents.Pop(false);
+		++NumReused;
+		INC_DWORD_STAT(STAT_FXReused);
+	}
+	else
+	{
+		Component = CreateComponent(System);
+		if (Component == nullptr) { return nullptr; }
+
+		++NumSpawned;
+		INC_DWORD_STAT(STAT_FXSpawned);
+	}
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->Activate(true);
+
+	Pool.ActiveComponents.Add(Component);
+	INC_DWORD_STAT(STAT_ActivePooledFX);
+
+	return Component;
+}
+
+
+UNiagaraComponent* UFXPoolSubsystem::SpawnPersistentSystemAtLocation(UNiagaraSystem* System, FVector Location, FRotator Rotation)
+{
+	if (System == nullptr) { return nullptr; }
+
+	UNiagaraComponent* Component = nullptr;
+
+	// room left: a new component; otherwise recycle the oldest persistent effect
+	if (PersistentComponents.Num() < FMath::Max(MaxPersistentFX, 1))
+	{
+		Component = CreateComponent(System);
+		if (Component == nullptr) { return nullptr; }
+
+		PersistentComponents.Add(Component);
+		++NumSpawned;
+		INC_DWORD_STAT(STAT_FXSpawned);
+	}
+	else
+	{
+		NextPersistentIndex %= PersistentComponents.Num();
+		Component = PersistentComponents[NextPersistentIndex];
+		NextPersistentIndex = (NextPersistentIndex + 1) % PersistentComponents.Num();
+
+		Component->DeactivateImmediate();
+		if (Component->GetAsset() != System) { Component->SetAsset(System); }
+
+		++NumReused;
+		INC_DWORD_STAT(STAT_FXReused);
+	}
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->Activate(true);
+
+	return Component;
+}
+
+
+void UFXPoolSubsystem::OnSystemFinished(UNiagaraComponent* Component)
+{
+	if (Component == nullptr) { return; }
+
+	FFXSystemPool* Pool = Pools.Find(Component->GetAsset());
+	if (Pool == nullptr || Pool->ActiveComponents.RemoveSingleSwap(Component, false) == 0) { return; }
+
+	Pool->FreeComponents.Add(Component);
+	DEC_DWORD_STAT(STAT_ActivePooledFX);
+}
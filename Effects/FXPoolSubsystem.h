@@ -0,0 +1,131 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FXPoolSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+// per-system limits (systems without an entry use the subsystem defaults)
+USTRUCT(BlueprintType)
+struct FFXSystemBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	UNiagaraSystem* System = nullptr;
+
+	// most instances playing at once; further spawns are rejected
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxActive = 8;
+
+	// components created up front
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 PrewarmCount = 2;
+
+	// spawns further than this from the player's camera are rejected (0 = never culled)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float CullDistance = 5000.f;
+};
+
+
+// the components of one system: idle, and currently playing
+USTRUCT()
+struct FFXSystemPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UNiagaraComponent*> FreeComponents;
+
+	UPROPERTY()
+	TArray<UNiagaraComponent*> ActiveComponents;
+};
+
+
+/**
+ *  routes gameplay niagara spawns (impacts, casing ejection, blood) through pre-warmed, per-system component pools.
+ *  each system has a concurrency cap and a cull distance; a finished system hands its component back to the pool.
+ *  effects that stay (blood pools, anything looping) never finish, so they go through a separate persistent pool
+ *  that is never culled and recycles its oldest effect once full. counts spawns (new components), reuses and rejections
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UFXPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UFXPoolSubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// play a system at a location; returns null if culled or over budget
+	UFUNCTION(BlueprintCallable, Category = "FX Pool")
+	UNiagaraComponent* SpawnSystemAtLocation(UNiagaraSystem* System, FVector Location, FRotator Rotation = FRotator::ZeroRotator);
+
+	// play a system that stays where it is put (e.g., a blood pool under a corpse); never culled or rejected, the oldest
+	// persistent effect is recycled instead once MaxPersistentFX are out. looping systems are always spawned this way
+	UFUNCTION(BlueprintCallable, Category = "FX Pool")
+	UNiagaraComponent* SpawnPersistentSystemAtLocation(UNiagaraSystem* System, FVector Location, FRotator Rotation = FRotator::ZeroRotator);
+
+	// make sure a system has its pre-warm count of components (cheap to call repeatedly)
+	UFUNCTION(BlueprintCallable, Category = "FX Pool")
+	void PrewarmSystem(UNiagaraSystem* System);
+
+	UFUNCTION(BlueprintPure, Category = "FX Pool")
+	FORCEINLINE int32 GetNumSpawned() const { return NumSpawned; }
+
+	UFUNCTION(BlueprintPure, Category = "FX Pool")
+	FORCEINLINE int32 GetNumReused() const { return NumReused; }
+
+	UFUNCTION(BlueprintPure, Category = "FX Pool")
+	FORCEINLINE int32 GetNumRejected() const { return NumRejected; }
+
+	/*
+	*  tuning
+	*/
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX Pool")
+	TArray<FFXSystemBudget> SystemBudgets;
+
+	// used for systems not listed in SystemBudgets
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX Pool")
+	FFXSystemBudget DefaultBudget;
+
+	// most persistent effects in the world at once (across all systems)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX Pool", meta = (ClampMin = 1))
+	int32 MaxPersistentFX;
+
+protected:
+
+	UPROPERTY(Transient)
+	TMap<UNiagaraSystem*, FFXSystemPool> Pools;
+
+	// persistent effects, recycled in spawn order (NextPersistentIndex is the oldest once full)
+	UPROPERTY(Transient)
+	TArray<UNiagaraComponent*> PersistentComponents;
+
+	int32 NextPersistentIndex;
+
+	// owns the pooled components
+	UPROPERTY(Transient)
+	AActor* FXOwner;
+
+	int32 NumSpawned;
+	int32 NumReused;
+	int32 NumRejected;
+
+	const FFXSystemBudget& GetBudget(const UNiagaraSystem* System) const;
+
+	bool IsCulled(const FVector& Location, float CullDistance) const;
+
+	UNiagaraComponent* CreateComponent(UNiagaraSystem* System);
+
+	// return a finished component to its pool
+	UFUNCTION()
+	void OnSystemFinished(UNiagaraComponent* Component);
+};
@@ -2,13 +2,26 @@
 
 
 #include "../Enemies/Enemy.h"
+#include "../Animation/EnemyMontageTable.h"
 #include "../Enemies/EnemyController.h"
+#include "../Enemies/EnemyArchetype.h"
+#include "../Enemies/EnemyTickManager.h"
+#include "../Enemies/EnemyStateStore.h"
+#include "../Enemies/EnemyTimerWheel.h"
+#include "../Enemies/RagdollBudgetSubsystem.h"
+#include "../Enemies/EnemyPerceptionSubsystem.h"
+#include "../Enemies/EnemyPoolSubsystem.h"
+#include "../Effects/DecalPoolSubsystem.h"
+#include "../Effects/FXPoolSubsystem.h"
+#include "../Framework/HitZoneSubsystem.h"
+#include "../Framework/LegacyDataMigration.h"
 #include "../PlayerCharacter/PlayerCharacter.h"
 #include "../DebugMacros.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimNotifies/AnimNotifyState_DisableRootMotion.h"
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -18,79 +31,61 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "NavigationSystem.h"
-#include "Perception/PawnSensingComponent.h"
 #include "Sound/SoundCue.h"
 
 
 // sets default values
 AEnemy::AEnemy()
 {
+	// AI updates are driven by the UEnemyTickManager; the actor tick is only needed for per-frame mesh adjustments (see SetIncapacitated)
+	// and blueprint Event Tick (see RefreshActorTickEnabled)
 	PrimaryActorTick.bCanEverTick = true;
-
-	PawnSensingComp = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("PawnSensingComp"));
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// create and attach combat range sphere to root component
 	CombatRangeSphere = CreateDefaultSubobject<USphereComponent>(TEXT("Combat Range Sphere"));
 	CombatRangeSphere->SetupAttachment(GetRootComponent());
 	CombatRangeSphere->InitSphereRadius(100.0);
 	
-	// set default enemy base stats
-	MaxHealth = 150.f;
-	Health = MaxHealth;
-	Damage = 35.f;
-
-	// set movement defaults
-	PassiveWalkSpeed = 20.f;
-	HostileWalkSpeed = 40.f;
-	GetCharacterMovement()->MaxWalkSpeed = PassiveWalkSpeed;
-	PassiveRotationRate = FRotator(0.f, 30.f, 0.f);
-	HostileRotationRate = FRotator(0.f, 90.f, 0.f);
-	IncapacitatedRotationRate = FRotator(0.f, 60.f, 0.f);
-	GetCharacterMovement()->RotationRate = PassiveRotationRate;
+	// set starting stats + movement from the default archetype (the real one is applied on BeginPlay)
+	const UEnemyArchetype* DefaultArchetype = GetDefault<UEnemyArchetype>();
+	Health = DefaultArchetype->MaxHealth;
+	AttackRange = DefaultArchetype->AttackRange;
+	MoveToAcceptanceRadius = DefaultArchetype->MoveToAcceptanceRadius;
+	GetCharacterMovement()->MaxWalkSpeed = DefaultArchetype->PassiveWalkSpeed;
+	GetCharacterMovement()->RotationRate = DefaultArchetype->PassiveRotationRate;
 
 	// set default awareness level and combat state
 	AwarenessLevel = EEnemyAwarenessLevel::EAL_Passive;
 	CombatState = EEnemyCombatState::ECS_Idle;
 
 	// set default combat modifiers
-	CombatRadius = 1000.f;
-	AttackRange = 100.f;
-	LungeAttackRange = 150.f;
-	CrawlingAttackRange = 125.f;
 	bAlive = true;
 	bIsRagdoll = false;
+	bRagdollFrozen = false;
+	bCorpseFinalized = false;
+	CorpseSettleCheckInterval = 0.5f;
+	bInEnemyPool = false;
+	Archetype = nullptr;
+	StateStore = nullptr;
+	StateIndex = INDEX_NONE;
+	TimerWheel = nullptr;
+	TimerBlock = INDEX_NONE;
 	bShouldPlayPhysicalHitReact = false;
+	HitReactMapId = INDEX_NONE;
+	bBlueprintTicks = false;
 	bStaggered = false;
 	bCanTakeDamage = true;
 	bInAttackRange = false;
 	bCanLookAtPlayer = true;
-	TakeDamageDelay = 0.25f;
-	AttackDelayMin = 1.f;
-	AttackDelayMax = 2.f;
 
 	// set default perception values
-	PerceptionRange = 2000.f;
-	VisionRange = 1500.f;
-	VisionAggroRange = VisionRange;
-	HearingAggroRange = PerceptionRange;
-	PeripheralVisionAngle = 75.f;
 	bCanSeePlayer = false;
 	PlayerLOSCheckFrequency = 1.f;
-	TargetLossDelay = 3.f;
-
-	PawnSensingComp->SetPeripheralVisionAngle(PeripheralVisionAngle);
-	PawnSensingComp->SightRadius = 2000.f;
 
 	// navigation defaults
 	DistanceToPlayerCharacter = 0.f;
-	PatrolAcceptanceRadius = 150.f;
-	PatrolIdleTimeMin = 10.f;
-	PatrolIdleTimeMax = 15.f;
-	PassiveRotateTowardsDelay = 2.f;
-	HostileRotateTowardsDelay = 1.f;
 	bIncapacitated = false;
-	MoveToAcceptanceRadius = 15.f;
-	CrawlingMoveToAcceptanceRadius = 45.f;
 
 	// hit react defaults
 	LeftLegHitCounter = 0;
@@ -104,12 +99,41 @@ AEnemy::AEnemy()
 	bEnableRightLegProfile = false;
 
 	// audio defaults
+	bCanPlayIdleSpeech = false;
+
+#if WITH_EDITORONLY_DATA
+	// legacy designer defaults, unchanged: older blueprints only saved where they differed from these
+	MaxHealth = 150.f;
+	Damage = 35.f;
+	PassiveWalkSpeed = 20.f;
+	HostileWalkSpeed = 40.f;
+	PassiveRotationRate = FRotator(0.f, 30.f, 0.f);
+	HostileRotationRate = FRotator(0.f, 90.f, 0.f);
+	IncapacitatedRotationRate = FRotator(0.f, 60.f, 0.f);
+	CombatRadius = 1000.f;
+	LungeAttackRange = 150.f;
+	CrawlingAttackRange = 125.f;
+	CrawlingMoveToAcceptanceRadius = 45.f;
+	TakeDamageDelay = 0.25f;
+	AttackDelayMin = 1.f;
+	AttackDelayMax = 2.f;
+	PerceptionRange = 2000.f;
+	VisionRange = 1500.f;
+	VisionAggroRange = VisionRange;
+	HearingAggroRange = PerceptionRange;
+	PeripheralVisionAngle = 75.f;
+	TargetLossDelay = 3.f;
+	PatrolAcceptanceRadius = 150.f;
+	PatrolIdleTimeMin = 10.f;
+	PatrolIdleTimeMax = 15.f;
+	PassiveRotateTowardsDelay = 2.f;
+	HostileRotateTowardsDelay = 1.f;
 	IdleCueIntervalMin = 5.f;
 	IdleCueIntervalMax = 12.f;
 	ChasingCueIntervalMin = 4.f;
 	ChasingCueIntervalMax = 6.f;
-	bCanPlayIdleSpeech = false;
-
+	LegacyArchetype = nullptr;
+#endif
 }
 
 // blueprint-callable setter for enemy awareness
@@ -117,33 +141,38 @@ AEnemy::AEnemy()
 void AEnemy::SetEnemyAwarenessLevel(EEnemyAwarenessLevel NewAwarenessLevel)
 {
 	// validate
-	if (NewAwarenessLevel == AwarenessLevel) { return; }
+	if (NewAwarenessLevel == GetEnemyAwarenessLevel()) { return; }
 
 	// update enemy's awareness level
-	AwarenessLevel = NewAwarenessLevel;
+	if (StateStore) { StateStore->AwarenessLevel[StateIndex] = NewAwarenessLevel; }
+	else { AwarenessLevel = NewAwarenessLevel; }
 
 	// set appropriate movement speed on character movement component
-	switch (AwarenessLevel)
+	switch (NewAwarenessLevel)
 	{
 		case EEnemyAwarenessLevel::EAL_Passive:
 			// clear any pending chasing speech cues + set speed/rotation rate
-			GetWorldTimerManager().ClearTimer(ChasingCue_TimerHandle);
-			GetCharacterMovement()->MaxWalkSpeed = PassiveWalkSpeed;
-			GetCharacterMovement()->RotationRate = PassiveRotationRate;
+			ClearEnemyTimer(EEnemyTimer::ET_ChasingCue);
+			GetCharacterMovement()->MaxWalkSpeed = GetArchetype().PassiveWalkSpeed;
+			GetCharacterMovement()->RotationRate = GetArchetype().PassiveRotationRate;
 			break;
 
 		case EEnemyAwarenessLevel::EAL_Hostile:
 			// clear any pending idle speech cues + set speed/rotation rate
-			GetWorldTimerManager().ClearTimer(IdleCue_TimerHandle);
-			GetCharacterMovement()->MaxWalkSpeed = bIncapacitated ? PassiveWalkSpeed : HostileWalkSpeed;
-			GetCharacterMovement()->RotationRate = bIncapacitated ? IncapacitatedRotationRate : HostileRotationRate;
+			ClearEnemyTimer(EEnemyTimer::ET_IdleCue);
+			GetCharacterMovement()->MaxWalkSpeed = bIncapacitated ? GetArchetype().PassiveWalkSpeed : GetArchetype().HostileWalkSpeed;
+			GetCharacterMovement()->RotationRate = bIncapacitated ? GetArchetype().IncapacitatedRotationRate : GetArchetype().HostileRotationRate;
 			break;
 
 		default:
-			GetCharacterMovement()->MaxWalkSpeed = PassiveWalkSpeed;
-			GetCharacterMovement()->RotationRate = PassiveRotationRate;
+			GetCharacterMovement()->MaxWalkSpeed = GetArchetype().PassiveWalkSpeed;
+			GetCharacterMovement()->RotationRate = GetArchetype().PassiveRotationRate;
 			break;
 	}
+
+	// move into the right update bucket immediately (e.g., hostile -> updated every frame)
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->RefreshSignificance(this); }
 }
 
 
@@ -151,17 +180,49 @@ void AEnemy::SetEnemyAwarenessLevel(EEnemyAwarenessLevel NewAwarenessLevel)
 void AEnemy::SetEnemyCombatState(EEnemyCombatState NewCombatState)
 {
 	// validate
-	if (NewCombatState == CombatState) { return; }
+	const EEnemyCombatState OldCombatState = GetEnemyCombatState();
+	if (NewCombatState == OldCombatState) { return; }
 	
 	// update combat state
-	PreviousCombatState = CombatState;
-	CombatState = NewCombatState;
+	PreviousCombatState = OldCombatState;
+	if (StateStore) { StateStore->CombatState[StateIndex] = NewCombatState; }
+	else { CombatState = NewCombatState; }
+}
+
+
+EEnemyAwarenessLevel AEnemy::GetEnemyAwarenessLevel() const { return StateStore ? StateStore->AwarenessLevel[StateIndex] : AwarenessLevel; }
+
+EEnemyCombatState AEnemy::GetEnemyCombatState() const { return StateStore ? StateStore->CombatState[StateIndex] : CombatState; }
+
+bool AEnemy::GetAlive() const { return StateStore ? StateStore->bAlive[StateIndex] != 0 : bAlive; }
+
+float AEnemy::GetAttackRange() const { return StateStore ? StateStore->AttackRange[StateIndex] : AttackRange; }
+
+
+void AEnemy::SetAlive(bool bNewAlive)
+{
+	if (StateStore) { StateStore->bAlive[StateIndex] = bNewAlive; }
+	else { bAlive = bNewAlive; }
+}
+
+
+void AEnemy::SetAttackRange(float NewAttackRange)
+{
+	if (StateStore) { StateStore->AttackRange[StateIndex] = NewAttackRange; }
+	else { AttackRange = NewAttackRange; }
 }
 
 
 // called when the game starts or when spawned
 void AEnemy::BeginPlay()
 {
+	// shared type data first, so BP BeginPlay can read the archetype
+	ApplyArchetype();
+
+	// BP Event Tick keeps working (the native tick starts disabled)
+	bBlueprintTicks = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AEnemy, ReceiveTick));
+	RefreshActorTickEnabled();
+
 	Super::BeginPlay();
 
 	CombatRangeSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatRangeSphereOverlap);
@@ -171,18 +232,38 @@ void AEnemy::BeginPlay()
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECR_Ignore);
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECR_Ignore);
 
+	// remember what recycling needs to restore
+	DefaultMeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+	DefaultMeshCollisionResponses = GetMesh()->GetCollisionResponseToChannels();
+	DefaultMeshRelativeTransform = GetMesh()->GetRelativeTransform();
+
 	SetEnemyCombatState(EEnemyCombatState::ECS_Idle);
 	SpawnLocation = GetActorLocation();
 
 	// get the AI controller
 	EnemyController = Cast<AEnemyController>(GetController());
 
-	if (PawnSensingComp)
+	// blood FX components ready before the first hit (no-op once the pools are warm)
+	if (UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>())
 	{
-		// bind PawnSeen to OnSeePawn delegate
-		PawnSensingComp->OnSeePawn.AddDynamic(this, &AEnemy::PawnSeen);
+		FXPool->PrewarmSystem(GetArchetype().BloodImpactParticles1);
+		FXPool->PrewarmSystem(GetArchetype().BloodImpactParticles2);
+		FXPool->PrewarmSystem(GetArchetype().BloodPool);
 	}
 
+	// hit react tables ready before the first hit
+	BuildHitZones();
+
+	// pre-warmed by the pool; stays dormant until acquired
+	if (bInEnemyPool)
+	{
+		DeactivateForPool();
+		return;
+	}
+
+	// stagger LOS checks so enemies that aggro together don't all trace on the same frame
+	LastPlayerLOSCheckTime = GetWorld()->GetTimeSeconds() - FMath::FRandRange(0.f, PlayerLOSCheckFrequency);
+
 	// if can patrol, do so
 	if (CanPatrol())
 	{
@@ -190,23 +271,71 @@ void AEnemy::BeginPlay()
 		MoveToTarget(PatrolTarget);
 	}
 
+	// hand AI updates over to the tick manager
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->RegisterEnemy(this); }
+
+	// sight/hearing are evaluated for all enemies at once by the perception subsystem (calls PawnSeen/PawnHeard)
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->RegisterEnemy(this); }
 }
 
-// called every frame
-void AEnemy::Tick(float DeltaTime)
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->UnregisterEnemy(this); }
+
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->UnregisterEnemy(this); }
+
+	if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+	{ Pool->RemoveEnemy(this); }
+
+	if (URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>())
+	{ RagdollBudget->ReleaseEnemy(this); }
+
+	if (UDecalPoolSubsystem* DecalPool = GetWorld()->GetSubsystem<UDecalPoolSubsystem>())
+	{ DecalPool->ReleaseDecalsOn(this); }
+
+	StopSpeechAudio();
+
+	// release timer wheel slots
+	if (TimerWheel)
+	{
+		TimerWheel->FreeBlock(TimerBlock);
+		TimerWheel = nullptr;
+		TimerBlock = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
 
-	switch (AwarenessLevel)
+
+// called by the tick manager at this enemy's significance-bucket rate
+void AEnemy::UpdateEnemyAI(float DeltaTime)
+{
+	// mirror the range pass result for blueprints
+	if (StateStore)
+	{ DistanceToPlayerCharacter = StateStore->DistanceToTarget[StateIndex]; }
+
+	switch (GetEnemyAwarenessLevel())
 	{
 	case EEnemyAwarenessLevel::EAL_Passive:
 		HandlePassiveStates();
 		break;
 
 	case EEnemyAwarenessLevel::EAL_Hostile:
-		HandleHostileStates();
+		HandleHostileStates(true);
 		break;
 	}
+}
+
+
+// called every frame (only enabled while incapacitated, or for BP Event Tick)
+void AEnemy::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
 
 	if (bIncapacitated) // adjustments for larger enemy type meshes when grounded
 	{
@@ -216,6 +345,12 @@ void AEnemy::Tick(float DeltaTime)
 }
 
 
+void AEnemy::RefreshActorTickEnabled()
+{
+	SetActorTickEnabled(bIncapacitated || bBlueprintTicks);
+}
+
+
 // detect overlap with player; set flags
 void AEnemy::CombatRangeSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
@@ -232,7 +367,7 @@ void AEnemy::CombatRangeSphereOverlap(UPrimitiveComponent* OverlappedComponent,
 			if (EnemyController)
 			{ EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), true); }
 
-			if (AwarenessLevel == EEnemyAwarenessLevel::EAL_Hostile)
+			if (GetEnemyAwarenessLevel() == EEnemyAwarenessLevel::EAL_Hostile)
 			{ CombatTarget = PC; }
 		}
 	}
@@ -259,22 +394,22 @@ void AEnemy::CombatRangeSphereOverlapEnd(UPrimitiveComponent* OverlappedComponen
 // does this enemy have patrol targets assigned, and are they passive?
 bool AEnemy::CanPatrol()
 {
-	return PatrolTargets.Num() > 0 && PatrolTarget && AwarenessLevel == EEnemyAwarenessLevel::EAL_Passive;
+	return PatrolTargets.Num() > 0 && PatrolTarget && GetEnemyAwarenessLevel() == EEnemyAwarenessLevel::EAL_Passive;
 }
 
 
 void AEnemy::CheckPatrolTarget()
 {
 	// have we reached current patrol target?
-	if (InTargetRange(PatrolTarget, PatrolAcceptanceRadius))
+	if (InTargetRange(PatrolTarget, GetArchetype().PatrolAcceptanceRadius))
 	{
 		// get a new patrol target
 		PatrolTarget = UpdatePatrolTarget();
 
 		// update state and set timer to head to new target
 		SetEnemyCombatState(EEnemyCombatState::ECS_Idle);
-		const float WaitTime = FMath::RandRange(PatrolIdleTimeMin, PatrolIdleTimeMax);
-		GetWorldTimerManager().SetTimer(Patrol_TimerHandle, this, &AEnemy::PatrolTimerFinished, WaitTime);
+		const float WaitTime = FMath::RandRange(GetArchetype().PatrolIdleTimeMin, GetArchetype().PatrolIdleTimeMax);
+		SetEnemyTimer(EEnemyTimer::ET_Patrol, &AEnemy::PatrolTimerFinished, WaitTime);
 	}
 }
 
@@ -302,39 +437,40 @@ AActor* AEnemy::UpdatePatrolTarget()
 
 void AEnemy::PatrolTimerFinished()
 {
-	if (AwarenessLevel != EEnemyAwarenessLevel::EAL_Hostile)
+	if (GetEnemyAwarenessLevel() != EEnemyAwarenessLevel::EAL_Hostile)
 	{
 		SetEnemyCombatState(EEnemyCombatState::ECS_Patrolling);
 		EnemyController->SetFocus(PatrolTarget);
-		GetWorldTimerManager().SetTimer(RotateTowards_TimerHandle, this, &AEnemy::MoveToCurrentPatrolTarget, PassiveRotateTowardsDelay);
+		SetEnemyTimer(EEnemyTimer::ET_RotateTowards, &AEnemy::MoveToCurrentPatrolTarget, GetArchetype().PassiveRotateTowardsDelay);
 	}
 }
 
 
 void AEnemy::ClearPatrolTimer()
 {
-	GetWorldTimerManager().ClearTimer(Patrol_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_Patrol);
 }
 
 
 void AEnemy::ClearRotateTowardsTimer()
 {
-	GetWorldTimerManager().ClearTimer(RotateTowards_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_RotateTowards);
 }
 
 void AEnemy::ClearAggroAfterHitTimer()
 {
-	GetWorldTimerManager().ClearTimer(AggroAfterHit_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_AggroAfterHit);
 }
 
 
 void AEnemy::PawnSeen(APawn* SeenPawn)
 {
 	if (SeenPawn->ActorHasTag(FName("Dead"))) { return; }
+	const EEnemyCombatState CurrentCombatState = GetEnemyCombatState();
 	const bool bShouldChaseTarget =
-		CombatState != EEnemyCombatState::ECS_Dead && bAlive &&
-		CombatState != EEnemyCombatState::ECS_Chasing &&
-		CombatState < EEnemyCombatState::ECS_Attacking &&
+		CurrentCombatState != EEnemyCombatState::ECS_Dead && GetAlive() &&
+		CurrentCombatState != EEnemyCombatState::ECS_Chasing &&
+		CurrentCombatState < EEnemyCombatState::ECS_Attacking &&
 		SeenPawn->ActorHasTag(FName("Player"));
 
 	if (bShouldChaseTarget)
@@ -353,18 +489,19 @@ void AEnemy::PawnSeen(APawn* SeenPawn)
 		RotateTowardsThenChasePlayer();
 
 		// quick fade out to any playing speech + play random chasing cue
-		if (ActiveSpeechAudio != nullptr && ActiveSpeechAudio->IsPlaying())
+		UAudioComponent* SpeechAudio = GetSpeechAudio();
+		if (SpeechAudio != nullptr && SpeechAudio->IsPlaying())
 		{
 			float FadeOutDuration = 0.5f;
-			ActiveSpeechAudio->FadeOut(FadeOutDuration, 0.f);
-			RandomSpeechCueToPlay = RandomChasingCue;
-			GetWorldTimerManager().SetTimer(ChasingCue_TimerHandle, this, &AEnemy::PlayRandomSpeechCue, FadeOutDuration);
+			SpeechAudio->FadeOut(FadeOutDuration, 0.f);
+			RandomSpeechCueToPlay = GetArchetype().RandomChasingCue;
+			SetEnemyTimer(EEnemyTimer::ET_ChasingCue, &AEnemy::PlayRandomSpeechCue, FadeOutDuration);
 		}
 
 		else
 		{
 			// immediately play a chasing cue
-			RandomSpeechCueToPlay = RandomChasingCue;
+			RandomSpeechCueToPlay = GetArchetype().RandomChasingCue;
 			PlayRandomSpeechCue();
 		}
 	}
@@ -379,7 +516,7 @@ void AEnemy::PawnHeard(APawn* HeardPawn)
 
 void AEnemy::HandlePassiveStates()
 {
-	if (!bAlive || AwarenessLevel != EEnemyAwarenessLevel::EAL_Passive) { return; }
+	if (!GetAlive() || GetEnemyAwarenessLevel() != EEnemyAwarenessLevel::EAL_Passive) { return; }
 
 	if (CanPatrol())
 	{
@@ -395,21 +532,23 @@ void AEnemy::HandlePassiveStates()
 }
 
 
-void AEnemy::HandleHostileStates()
+void AEnemy::HandleHostileStates(bool bFromStatePass)
 {
-	if (!bAlive || !HasCombatTarget()) { return; }
+	if (!GetAlive() || !HasCombatTarget()) { return; }
 
+	// result arrives next frame via OnPlayerLOSResolved
 	if (GetWorld()->TimeSince(LastPlayerLOSCheckTime) > PlayerLOSCheckFrequency)
-	{
-		CheckPlayerLOS();
+	{ CheckPlayerLOS(); }
 
-		if (!bCanSeePlayer && GetWorldTimerManager().IsTimerActive(TargetLoss_TimerHandle) == false)
-		{ GetWorldTimerManager().SetTimer(TargetLoss_TimerHandle, this, &AEnemy::LoseTarget, TargetLossDelay); }
-	}
+	// within the manager's update, lose interest / chase were already decided by this frame's decision pass;
+	// anywhere else (e.g., an attack timer ending), decide from current state
+	const EEnemyHostileDecision Decision = (bFromStatePass && StateStore) ? StateStore->HostileDecision[StateIndex] : GetHostileDecision();
 
-	if (CombatTarget->ActorHasTag(FName("Dead")) || IsPlayerOutsideCombatRadius()) { LoseInterestInPlayer(); }
+	if (Decision == EEnemyHostileDecision::EHD_None) { return; }
 
-	else if (IsPlayerOutsideAttackRange() && !IsPlayerInsideLungeAttackRange() && !IsEnemyChasing())
+	if (Decision == EEnemyHostileDecision::EHD_LoseInterest) { LoseInterestInPlayer(); }
+
+	else if (Decision == EEnemyHostileDecision::EHD_Chase)
 	{
 		ClearAttackTimer();
 		if (!IsEnemyEngaged()) { ChasePlayer(); }
@@ -442,10 +581,11 @@ void AEnemy::MoveToCurrentCombatTarget()
 void AEnemy::SetIncapacitated()
 {
 	bIncapacitated = true;
-	GetCharacterMovement()->MaxWalkSpeed = PassiveWalkSpeed;
-	GetCharacterMovement()->RotationRate = IncapacitatedRotationRate;
-	AttackRange = CrawlingAttackRange;
-	MoveToAcceptanceRadius = CrawlingMoveToAcceptanceRadius;
+	RefreshActorTickEnabled(); // crawling capsule offset is applied per frame
+	GetCharacterMovement()->MaxWalkSpeed = GetArchetype().PassiveWalkSpeed;
+	GetCharacterMovement()->RotationRate = GetArchetype().IncapacitatedRotationRate;
+	SetAttackRange(GetArchetype().CrawlingAttackRange);
+	MoveToAcceptanceRadius = GetArchetype().CrawlingMoveToAcceptanceRadius;
 	EnemyController->StopMovement();
 	MoveToCurrentCombatTarget();
 	PlayIncapacitatedSFX();
@@ -462,9 +602,80 @@ bool AEnemy::InTargetRange(AActor* Target, float AcceptanceRadius)
 }
 
 
+// combat target range checks read this frame's range pass when managed; fall back to measuring directly (unmanaged, or
+// a target acquired since the pass)
+bool AEnemy::IsCombatTargetInRange(uint8 RangeFlag, float Range)
+{
+	if (CombatTarget == nullptr) { return false; }
+
+	if (StateStore && StateStore->bHasTarget[StateIndex])
+	{ return (StateStore->RangeFlags[StateIndex] & RangeFlag) != 0; }
+
+	return InTargetRange(CombatTarget, Range);
+}
+
+
+bool AEnemy::IsPlayerOutsideCombatRadius() { return !IsCombatTargetInRange(EEnemyRangeFlags::ERF_InCombatRadius, GetArchetype().CombatRadius); }
+
+bool AEnemy::IsPlayerOutsideAttackRange() { return !IsCombatTargetInRange(EEnemyRangeFlags::ERF_InAttackRange, GetAttackRange()); }
+
+bool AEnemy::IsPlayerOutsideLungeAttackRange() { return !IsCombatTargetInRange(EEnemyRangeFlags::ERF_InLungeAttackRange, GetArchetype().LungeAttackRange); }
+
+bool AEnemy::IsPlayerInsideAttackRange() { return IsCombatTargetInRange(EEnemyRangeFlags::ERF_InAttackRange, GetAttackRange()); }
+
+bool AEnemy::IsPlayerInsideLungeAttackRange() { return IsCombatTargetInRange(EEnemyRangeFlags::ERF_InLungeAttackRange, GetArchetype().LungeAttackRange); }
+
+
+// same rules as FEnemyStateStore::RunDecisionPass, evaluated on the spot (unmanaged enemies, or outside the manager's pass)
+EEnemyHostileDecision AEnemy::GetHostileDecision()
+{
+	if (!GetAlive() || !HasCombatTarget() || GetEnemyAwarenessLevel() != EEnemyAwarenessLevel::EAL_Hostile) { return EEnemyHostileDecision::EHD_None; }
+
+	if (CombatTarget->ActorHasTag(FName("Dead")) || IsPlayerOutsideCombatRadius()) { return EEnemyHostileDecision::EHD_LoseInterest; }
+
+	if (IsPlayerOutsideAttackRange() && !IsPlayerInsideLungeAttackRange() && !IsEnemyChasing()) { return EEnemyHostileDecision::EHD_Chase; }
+
+	return EEnemyHostileDecision::EHD_Evaluate;
+}
+
+
+void AEnemy::SetEnemyTimer(EEnemyTimer Timer, void (AEnemy::*Callback)(), float Delay)
+{
+	// slots are allocated the first time this enemy uses a timer
+	if (TimerWheel == nullptr)
+	{
+		UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>();
+		if (TickManager == nullptr) { return; }
+
+		TimerWheel = &TickManager->GetTimerWheel();
+		TimerBlock = TimerWheel->AllocateBlock(this);
+	}
+
+	TimerWheel->Schedule(TimerBlock, Timer, Callback, Delay);
+}
+
+
+void AEnemy::ClearEnemyTimer(EEnemyTimer Timer)
+{
+	if (TimerWheel) { TimerWheel->Cancel(TimerBlock, Timer); }
+}
+
+
+bool AEnemy::IsEnemyTimerActive(EEnemyTimer Timer) const
+{
+	return TimerWheel != nullptr && TimerWheel->IsActive(TimerBlock, Timer);
+}
+
+
+void AEnemy::ClearAllEnemyTimers()
+{
+	if (TimerWheel) { TimerWheel->CancelAll(TimerBlock); }
+}
+
+
 void AEnemy::MoveToTarget(AActor* Target)
 {
-	if (EnemyController == nullptr || Target == nullptr || !bAlive) { return; }
+	if (EnemyController == nullptr || Target == nullptr || !GetAlive()) { return; }
 	
 	// stop current movement
 	EnemyController->StopMovement();
@@ -481,14 +692,14 @@ void AEnemy::MoveToTarget(AActor* Target)
 
 void AEnemy::MoveToCurrentPatrolTarget()
 {
-	if (PatrolTarget && AwarenessLevel != EEnemyAwarenessLevel::EAL_Hostile) { MoveToTarget(PatrolTarget); }
+	if (PatrolTarget && GetEnemyAwarenessLevel() != EEnemyAwarenessLevel::EAL_Hostile) { MoveToTarget(PatrolTarget); }
 }
 
 // setter for enemy health
 float AEnemy::ModifyHealth(const float Delta)
 {
 	const float OldHealth = Health;
-	Health = FMath::Clamp<float>(Health + Delta, 0.0f, MaxHealth);
+	Health = FMath::Clamp<float>(Health + Delta, 0.0f, GetArchetype().MaxHealth);
 
 	return Health - OldHealth;
 }
@@ -505,9 +716,9 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 		{ PlayerCharacter = PC; }
 		
 		// interrupt any relevant audio (playing or pending play);
-		if (ActiveSpeechAudio != nullptr) { ActiveSpeechAudio->Stop(); }
+		StopSpeechAudio();
 		if (ActiveCrawlingAudio != nullptr) { ActiveCrawlingAudio->Stop(); }
-		GetWorldTimerManager().ClearTimer(ChasingCue_TimerHandle);
+		ClearEnemyTimer(EEnemyTimer::ET_ChasingCue);
 
 		// call parent function
 		Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
@@ -526,38 +737,34 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 		else // still alive after damage proc
 		{
 			// reset can take damage flag
-			GetWorldTimerManager().SetTimer(TakeDamage_TimerHandle, this, &AEnemy::ResetCanTakeDamage, TakeDamageDelay);
+			SetEnemyTimer(EEnemyTimer::ET_TakeDamage, &AEnemy::ResetCanTakeDamage, GetArchetype().TakeDamageDelay);
 
 			// play random hurt cue
-			RandomSpeechCueToPlay = RandomHurtCue;
+			RandomSpeechCueToPlay = GetArchetype().RandomHurtCue;
 			PlayRandomSpeechCue();
 			
-			// play the appropriate hit reaction anim
-			FHitReact HitReactData = GetHitReactToPlay();
-			PlayAnimMontage(HitReactData.MontageToPlay, 1.f, HitReactData.SectionToPlay);
-
-			// note duration of section in case we need to set an aggro timer
-			int32 SectionToPlayIndex = HitReactData.MontageToPlay->GetSectionIndex(HitReactData.SectionToPlay);
-			float AnimDuration = HitReactData.MontageToPlay->GetSectionLength(SectionToPlayIndex) - .25f;
+			// play the appropriate hit reaction anim, noting duration of section in case we need to set an aggro timer
+			float AnimDuration = GetHitReactToPlay().Play(GetMesh()->GetAnimInstance()) - .25f;
 			if (AnimDuration <= 0.f) { AnimDuration = .5f; }
 
-			// play physics simulated hit react on torso + certain bones only
+			// play physics simulated hit react on torso + certain bones only, if the physics budget allows it
 			if (bShouldPlayPhysicalHitReact) // determined in GetHitReactToPlay()
 			{
-				PlayPhysicalHitReact();
+				URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>();
+				if (RagdollBudget == nullptr || RagdollBudget->RequestPhysicalHitReact(this)) { PlayPhysicalHitReact(); }
 				bShouldPlayPhysicalHitReact = false;
 			}
 
 			// aggro upon receiving damage if not already hostile
-			if (AwarenessLevel != EEnemyAwarenessLevel::EAL_Hostile)
+			if (GetEnemyAwarenessLevel() != EEnemyAwarenessLevel::EAL_Hostile)
 			{
 				CombatTarget = EventInstigator->GetPawn();
-				GetWorldTimerManager().SetTimer(AggroAfterHit_TimerHandle, this, &AEnemy::AggroAfterHit, AnimDuration);
+				SetEnemyTimer(EEnemyTimer::ET_AggroAfterHit, &AEnemy::AggroAfterHit, AnimDuration);
 			}
 
 			// already hostile
 			else
-			{ GetWorldTimerManager().SetTimer(HitReact_TimerHandle, this, &AEnemy::MoveToCurrentCombatTarget, AnimDuration); }
+			{ SetEnemyTimer(EEnemyTimer::ET_HitReact, &AEnemy::MoveToCurrentCombatTarget, AnimDuration); }
 
 			return DamageAmount;
 		}
@@ -570,7 +777,7 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 void AEnemy::Die(AActor* Causer)
 {
 	// clear any active audio / pending timers + stop movement
-	if (ActiveSpeechAudio != nullptr && ActiveSpeechAudio->IsPlaying()) { ActiveSpeechAudio->Stop(); }
+	StopSpeechAudio();
 	if (ActiveCrawlingAudio != nullptr && ActiveCrawlingAudio->IsPlaying()) { ActiveCrawlingAudio->Stop(); }
 	ClearIdleSpeechCueTimer();
 	ClearChasingSpeechCueTimer();
@@ -584,30 +791,138 @@ void AEnemy::Die(AActor* Causer)
 	// play death anim
 	float AnimDuration = PlayDeathMontage();
 	
-	RandomSpeechCueToPlay = RandomDeathCue;	
+	RandomSpeechCueToPlay = GetArchetype().RandomDeathCue;	
 	PlayRandomSpeechCue();
-	GetWorldTimerManager().SetTimer(DeathEnd_TimerHandle, this, &AEnemy::DeathEnd, 2.f);
+	SetEnemyTimer(EEnemyTimer::ET_DeathEnd, &AEnemy::DeathEnd, 2.f);
 
 	// change status
-	bAlive = false;
+	SetAlive(false);
 	SetEnemyCombatState(EEnemyCombatState::ECS_Dead);
 	bCanLookAtPlayer = false;
 	StopRespawn();
 
+	// corpse can now be recycled for this zone's respawns
+	if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+	{ Pool->NotifyEnemyDied(this); }
+
 	SetIgnoreBloodChannel(); // BP; ignore blood trace channel collisions
 }
 
 
+void AEnemy::PlayBloodHitFX_Implementation(FHitResult Hit)
+{
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool == nullptr) { return; }
+
+	const FRotator ImpactRotation = Hit.ImpactNormal.Rotation();
+	FXPool->SpawnSystemAtLocation(GetArchetype().BloodImpactParticles1, Hit.ImpactPoint, ImpactRotation);
+	FXPool->SpawnSystemAtLocation(GetArchetype().BloodImpactParticles2, Hit.ImpactPoint, ImpactRotation);
+}
+
+
+void AEnemy::SpawnBloodPoolBP_Implementation()
+{
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool == nullptr || GetArchetype().BloodPool == nullptr) { return; }
+
+	// find the floor under the body (the mesh may have moved away from the capsule while ragdolled)
+	const FVector BodyLocation = GetMesh()->Bounds.Origin;
+	FVector PoolLocation = GetActorLocation() - FVector(0.f, 0.f, GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+
+	FHitResult FloorHit;
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(this);
+	if (GetWorld()->LineTraceSingleByChannel(FloorHit, BodyLocation, BodyLocation - FVector(0.f, 0.f, 500.f), ECollisionChannel::ECC_Visibility, QueryParams))
+	{ PoolLocation = FloorHit.ImpactPoint; }
+
+	// stays under the corpse: not subject to the transient FX budget / cull distance
+	FXPool->SpawnPersistentSystemAtLocation(GetArchetype().BloodPool, PoolLocation);
+}
+
+
 void AEnemy::DeathEnd()
 {
 	UCapsuleComponent* CapsuleComp = GetCapsuleComponent();
 	CapsuleComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	SpawnBloodPoolBP();
+
+	// once the body stops moving, reduce it to a static posed mesh
+	SetEnemyTimer(EEnemyTimer::ET_FinalizeCorpse, &AEnemy::TryFinalizeCorpse, CorpseSettleCheckInterval);
+}
+
+
+void AEnemy::TryFinalizeCorpse()
+{
+	if (GetAlive() || bCorpseFinalized) { return; }
+
+	// simulating ragdolls are finalized when the ragdoll budget freezes them (see FreezeRagdoll)
+	if (bIsRagdoll && !bRagdollFrozen) { return; }
+
+	// still playing out the death anim; check again shortly
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (AnimInstance && AnimInstance->IsAnyMontagePlaying())
+	{
+		SetEnemyTimer(EEnemyTimer::ET_FinalizeCorpse, &AEnemy::TryFinalizeCorpse, CorpseSettleCheckInterval);
+		return;
+	}
+
+	FinalizeCorpse();
+}
+
+
+// shut down everything a settled corpse doesn't need; meshes keep their last pose (and attached decals / blood pool stay)
+void AEnemy::FinalizeCorpse()
+{
+	if (bCorpseFinalized) { return; }
+	bCorpseFinalized = true;
+
+	// out of every AI / physics system
+	ClearAllEnemyTimers();
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->UnregisterEnemy(this); }
+
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->UnregisterEnemy(this); }
+
+	if (URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>())
+	{ RagdollBudget->ReleaseEnemy(this); }
+
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+		if (EnemyController->BrainComponent) { EnemyController->BrainComponent->StopLogic(TEXT("Corpse")); }
+	}
+
+	// (a still-playing death cue is left to finish; its pooled voice frees itself)
+	if (ActiveCrawlingAudio != nullptr) { ActiveCrawlingAudio->Stop(); }
+
+	// no more overlaps
+	CombatRangeSphere->SetGenerateOverlapEvents(false);
+	CombatRangeSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// snapshot the current pose: no anim evaluation, bone refresh, or skinning data updates from here on (clothing/hair too)
+	TInlineComponentArray<USkeletalMeshComponent*> SkeletalMeshes(this);
+	for (USkeletalMeshComponent* SkeletalMesh : SkeletalMeshes)
+	{
+		SkeletalMesh->SetNoSkeletonUpdate(true);
+		SkeletalMesh->bPauseAnims = true;
+		SkeletalMesh->SetComponentTickEnabled(false);
+	}
+
+	// body mesh stays query-only so traces (bullets, blood) still hit it
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+
+	SetActorTickEnabled(false);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
 }
 
 
 void AEnemy::StartRagdoll()
 {
+	// over the simulation budget (and less relevant than every active ragdoll): keep the animated death pose instead
+	URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>();
+	if (!bIsRagdoll && RagdollBudget && !RagdollBudget->RequestRagdoll(this)) { return; }
+
 	GetMesh()->SetCollisionProfileName(TEXT("Ragdoll"));
 
 	if (!bIsRagdoll)
@@ -627,6 +942,256 @@ void AEnemy::StartRagdoll()
 }
 
 
+// stop simulating, keeping the current (physics) pose; called by the ragdoll budget once settled or evicted
+void AEnemy::FreezeRagdoll()
+{
+	if (!bIsRagdoll || bRagdollFrozen) { return; }
+
+	USkeletalMeshComponent* MeshComp = GetMesh();
+
+	// stop refreshing bones first, so dropping out of simulation doesn't snap back to the animated pose
+	MeshComp->SetNoSkeletonUpdate(true);
+	MeshComp->bPauseAnims = true;
+	MeshComp->SetAllBodiesSimulatePhysics(false);
+	MeshComp->SetComponentTickEnabled(false);
+
+	// still hittable by traces (blood decals etc.), no longer part of the physics scene
+	MeshComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+
+	bRagdollFrozen = true;
+
+	// a frozen ragdoll is a settled corpse
+	if (!GetAlive()) { FinalizeCorpse(); }
+}
+
+
+const UEnemyArchetype& AEnemy::GetArchetype() const
+{
+	if (Archetype) { return *Archetype; }
+
+#if WITH_EDITORONLY_DATA
+	// not migrated yet (see MigrateToArchetype); keep playing as authored
+	if (LegacyArchetype == nullptr) { LegacyArchetype = FLegacyDataMigration::MakeTransientAsset<UEnemyArchetype>(*this); }
+	return *LegacyArchetype;
+#else
+	return *GetDefault<UEnemyArchetype>();
+#endif
+}
+
+
+void AEnemy::ApplyArchetype()
+{
+	// caught by data validation (see IsDataValid); the fallback only keeps a broken enemy from crashing
+	ensureMsgf(Archetype, TEXT("%s has no enemy archetype; using fallback values"), *GetName());
+
+	// the only per-instance copies: health, and the ranges that switch to their crawling values (see SetIncapacitated)
+	Health = GetArchetype().MaxHealth;
+	SetAttackRange(GetArchetype().AttackRange);
+	MoveToAcceptanceRadius = GetArchetype().MoveToAcceptanceRadius;
+	GetCharacterMovement()->MaxWalkSpeed = GetArchetype().PassiveWalkSpeed;
+	GetCharacterMovement()->RotationRate = GetArchetype().PassiveRotationRate;
+
+	// enemies sharing a bone map (whatever archetype it came from) share its compiled tables
+	if (UHitZoneSubsystem* HitZones = GetWorld()->GetSubsystem<UHitZoneSubsystem>())
+	{ HitReactMapId = HitZones->RegisterHitReactMap(GetArchetype().BoneHitReactMap); }
+}
+
+
+void AEnemy::BuildHitZones()
+{
+	UHitZoneSubsystem* HitZones = GetWorld()->GetSubsystem<UHitZoneSubsystem>();
+	if (HitZones == nullptr) { return; }
+
+	// every skeletal mesh this enemy can be hit on (body + appearance parts, or the merged body)
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComps(this);
+	for (const USkeletalMeshComponent* MeshComp : MeshComps)
+	{
+		const USkeletalMesh* Mesh = MeshComp->GetSkeletalMeshAsset();
+		HitZones->RegisterHitMesh(Mesh);
+		HitZones->GetHitReactTable(Mesh, HitReactMapId);
+	}
+
+	HitReactZones = HitZones->GetHitReactTable(GetMesh()->GetSkeletalMeshAsset(), HitReactMapId);
+}
+
+
+#if WITH_EDITOR
+void AEnemy::MigrateToArchetype()
+{
+	if (Archetype) { return; }
+
+	UEnemyArchetype* NewArchetype = FLegacyDataMigration::CreateAsset<UEnemyArchetype>(*this, TEXT("_Archetype"));
+	if (NewArchetype == nullptr) { return; }
+
+	Modify();
+	Archetype = NewArchetype;
+	LegacyArchetype = nullptr;
+	MarkPackageDirty();
+}
+
+
+EDataValidationResult AEnemy::IsDataValid(FDataValidationContext& Context) const
+{
+	return CombineDataValidationResults(Super::IsDataValid(Context), FLegacyDataMigration::ValidateAssigned(*this, Archetype, TEXT("enemy archetype"), Context));
+}
+#endif
+
+
+void AEnemy::ResetForReuse(const FTransform& SpawnTransform)
+{
+	const AEnemy* Defaults = GetClass()->GetDefaultObject<AEnemy>();
+
+	// pre-warmed enemies only get their controller after BeginPlay
+	EnemyController = Cast<AEnemyController>(GetController());
+
+	// nothing from the previous life should fire
+	ClearAllEnemyTimers();
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	StopSpeechAudio();
+	if (ActiveCrawlingAudio != nullptr) { ActiveCrawlingAudio->Stop(); }
+	StopAnimMontage();
+
+	// bullet holes / blood from the previous life
+	if (UDecalPoolSubsystem* DecalPool = GetWorld()->GetSubsystem<UDecalPoolSubsystem>())
+	{ DecalPool->ReleaseDecalsOn(this); }
+
+	// undo ragdoll: stop simulating + snap the mesh back under the capsule
+	if (URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>())
+	{ RagdollBudget->ReleaseEnemy(this); }
+
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	MeshComp->SetNoSkeletonUpdate(false);
+	MeshComp->bPauseAnims = false;
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->SetAllBodiesSimulatePhysics(false);
+	MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	MeshComp->SetRelativeTransform(DefaultMeshRelativeTransform);
+	MeshComp->SetCollisionProfileName(DefaultMeshCollisionProfile);
+	MeshComp->SetCollisionResponseToChannels(DefaultMeshCollisionResponses);
+	bIsRagdoll = false;
+	bRagdollFrozen = false;
+
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	SpawnLocation = SpawnTransform.GetLocation();
+
+	// stats + flags
+	Health = GetArchetype().MaxHealth;
+	SetAlive(true);
+	bIncapacitated = false;
+	bStaggered = false;
+	bCanTakeDamage = true;
+	bInAttackRange = false;
+	bCanLookAtPlayer = true;
+	bCanSeePlayer = false;
+	bShouldPlayPhysicalHitReact = false;
+	CombatTarget = nullptr;
+	SetAttackRange(GetArchetype().AttackRange);
+	MoveToAcceptanceRadius = GetArchetype().MoveToAcceptanceRadius;
+
+	// hit react counters + limb profiles
+	LeftLegHitCounter = 0;
+	RightLegHitCounter = 0;
+	LeftArmHitCounter = 0;
+	RightArmHitCounter = 0;
+	HeadHitCounter = 0;
+	bEnableLeftArmProfile = false;
+	bEnableRightArmProfile = false;
+	bEnableLeftLegProfile = false;
+	bEnableRightLegProfile = false;
+
+	// back to being a visible, collidable, moving actor
+	bInEnemyPool = false;
+	RefreshActorTickEnabled();
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	// undo corpse finalization (see FinalizeCorpse)
+	TInlineComponentArray<USkeletalMeshComponent*> SkeletalMeshes(this);
+	for (USkeletalMeshComponent* SkeletalMesh : SkeletalMeshes)
+	{
+		SkeletalMesh->SetNoSkeletonUpdate(false);
+		SkeletalMesh->bPauseAnims = false;
+		SkeletalMesh->SetComponentTickEnabled(true);
+	}
+
+	CombatRangeSphere->SetCollisionEnabled(Defaults->CombatRangeSphere->GetCollisionEnabled());
+	CombatRangeSphere->SetGenerateOverlapEvents(true);
+	bCorpseFinalized = false;
+
+	if (EnemyController && EnemyController->BrainComponent)
+	{ EnemyController->BrainComponent->RestartLogic(); }
+
+	UCharacterMovementComponent* CharacterComp = GetCharacterMovement();
+	CharacterComp->SetComponentTickEnabled(true);
+	CharacterComp->SetMovementMode(EMovementMode::MOVE_Walking);
+
+	SetEnemyAwarenessLevel(EEnemyAwarenessLevel::EAL_Passive);
+	SetEnemyCombatState(EEnemyCombatState::ECS_Idle);
+	CharacterComp->MaxWalkSpeed = GetArchetype().PassiveWalkSpeed;
+	CharacterComp->RotationRate = GetArchetype().PassiveRotationRate;
+
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+		EnemyController->SetFocus(NULL);
+	}
+
+	RandomizeAppearanceBP();
+	RebuildAppearance();
+
+	// back under the AI managers
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->RegisterEnemy(this); }
+
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->RegisterEnemy(this); }
+
+	LastPlayerLOSCheckTime = GetWorld()->GetTimeSeconds() - FMath::FRandRange(0.f, PlayerLOSCheckFrequency);
+
+	if (CanPatrol())
+	{
+		SetEnemyCombatState(EEnemyCombatState::ECS_Patrolling);
+		MoveToTarget(PatrolTarget);
+	}
+}
+
+
+void AEnemy::DeactivateForPool()
+{
+	bInEnemyPool = true;
+
+	ClearAllEnemyTimers();
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	StopSpeechAudio();
+	if (ActiveCrawlingAudio != nullptr) { ActiveCrawlingAudio->Stop(); }
+
+	if (UEnemyTickManager* TickManager = GetWorld()->GetSubsystem<UEnemyTickManager>())
+	{ TickManager->UnregisterEnemy(this); }
+
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->UnregisterEnemy(this); }
+
+	if (URagdollBudgetSubsystem* RagdollBudget = GetWorld()->GetSubsystem<URagdollBudgetSubsystem>())
+	{ RagdollBudget->ReleaseEnemy(this); }
+
+	if (UDecalPoolSubsystem* DecalPool = GetWorld()->GetSubsystem<UDecalPoolSubsystem>())
+	{ DecalPool->ReleaseDecalsOn(this); }
+
+	if (EnemyController) { EnemyController->StopMovement(); }
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	// no animation work while hidden
+	TInlineComponentArray<USkeletalMeshComponent*> SkeletalMeshes(this);
+	for (USkeletalMeshComponent* SkeletalMesh : SkeletalMeshes)
+	{ SkeletalMesh->SetComponentTickEnabled(false); }
+}
+
+
 void AEnemy::AggroAfterHit()
 {
 	// turn to face direction attacked from
@@ -679,182 +1244,85 @@ ELastHitDirection AEnemy::GetLastHitDirection()
 EBoneHitReactValue AEnemy::GetLastBoneHitMapping()
 {
 	// check if last bone hit (set by weapon when hit determined) was limb or torso
-	EBoneHitReactValue BoneHitReact = EBoneHitReactValue::EBHR_Torso;
-	for (auto& Bone : BoneHitReactMap)
+	const TMap<FName, EBoneHitReactValue>& BoneMap = GetArchetype().BoneHitReactMap;
+	EBoneHitReactValue BoneHitReact = EBoneHitReactValue::EBHR_MAX;
+
+	// skeletal hit: one lookup by bone index in the table compiled for the hit mesh (unmapped bones inherit their parent's zone)
+	const USkeletalMeshComponent* HitMeshComp = Cast<USkeletalMeshComponent>(LastHitResult.GetComponent());
+	const USkeletalMesh* HitMesh = HitMeshComp ? HitMeshComp->GetSkeletalMeshAsset() : nullptr;
+	if (HitMesh && (!HitReactZones.IsValid() || HitReactZones->Mesh != TObjectKey<USkeletalMesh>(HitMesh)))
 	{
-		if (LastBoneHit == Bone.Key)
+		if (UHitZoneSubsystem* HitZones = GetWorld()->GetSubsystem<UHitZoneSubsystem>())
 		{
-			bLastHitWasLimb = true;
-			BoneHitReact = Bone.Value;
-			break;
+			HitReactZones = HitZones->GetHitReactTable(HitMesh, HitReactMapId);
 		}
-
-		bLastHitWasLimb = false;
 	}
 
-	return BoneHitReact;
+	if (HitMesh && HitReactZones.IsValid())
+	{ BoneHitReact = HitReactZones->Get(UHitZoneSubsystem::GetHitBoneIndex(LastHitResult)); }
+
+	// anything else: by name
+	else if (const EBoneHitReactValue* Mapped = BoneMap.Find(LastBoneHit))
+	{ BoneHitReact = *Mapped; }
+
+	bLastHitWasLimb = BoneHitReact != EBoneHitReactValue::EBHR_MAX;
+
+	return bLastHitWasLimb ? BoneHitReact : EBoneHitReactValue::EBHR_Torso;
 }
 
-FHitReact AEnemy::GetHitReactToPlay()
+const FMontageSection& AEnemy::GetHitReactToPlay()
 {
 	// get direction and bone mapping of last hit
 	ELastHitDirection LastHitDirection = GetLastHitDirection();
 	EBoneHitReactValue LastBoneHitReact = GetLastBoneHitMapping();
+	const FHitReactTable& HitReacts = GetMontageTable().HitReacts;
 
-	// determine which montage and section to play
-	UAnimMontage* MontageToPlay;
-	FName SectionToPlay;
+	// leg hits count from any direction; head + arm hits only from the front (limb anims only read right from there)
+	const bool bFromFront = LastHitDirection == ELastHitDirection::ELHD_Front;
+	int32* LimbHitCounter = nullptr;
+	bool* LimbProfile = nullptr;
 
-	// leg anims are ok to play from any direction, as are torso anims
-	if (LastHitDirection != ELastHitDirection::ELHD_Front || LastBoneHitReact == EBoneHitReactValue::EBHR_Torso)
+	switch (LastBoneHitReact)
 	{
-		MontageToPlay = HitReactsLimbs;
-
-		if (LastBoneHitReact == EBoneHitReactValue::EBHR_LeftLeg)
-		{ 
-			LeftLegHitCounter ++;
-			if (LeftLegHitCounter >= 2) 
-			{ 
-				MontageToPlay = HitReactsLimbs;
-				SectionToPlay = FName("LeftLeg");
-				LeftLegHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-			}
-		}
-
-		else if (LastBoneHitReact == EBoneHitReactValue::EBHR_RightLeg)
-		{ 
-			RightLegHitCounter ++;
-			if (RightLegHitCounter >= 2) 
-			{
-				MontageToPlay = HitReactsLimbs;
-				SectionToPlay = FName("RightLeg");
-				RightLegHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-			}
-		}
-
-		else
-		{
-			// torso; play appropriate directional torso anim
-			MontageToPlay = HitReactsTorso;
-			SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-			bShouldPlayPhysicalHitReact = true;
-		}
-	}
+	case EBoneHitReactValue::EBHR_Head:
+		if (bFromFront) { LimbHitCounter = &HeadHitCounter; }
+		break;
 
-	// hit a limb from the front:: all anims valid
-	else
-	{
-		MontageToPlay = HitReactsLimbs;
+	case EBoneHitReactValue::EBHR_LeftArm:
+		if (bFromFront) { LimbHitCounter = &LeftArmHitCounter; LimbProfile = &bEnableLeftArmProfile; }
+		break;
 
-		switch (LastBoneHitReact)
-		{
-		case EBoneHitReactValue::EBHR_Head:
-			HeadHitCounter++;
-			if (HeadHitCounter >= 2)
-			{
-				SectionToPlay = FName("Head");
-				HeadHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-			}
-			break;
+	case EBoneHitReactValue::EBHR_RightArm:
+		if (bFromFront) { LimbHitCounter = &RightArmHitCounter; LimbProfile = &bEnableRightArmProfile; }
+		break;
 
-		case EBoneHitReactValue::EBHR_LeftArm:
-			LeftArmHitCounter++;
-			if (LeftArmHitCounter >= 2)
-			{
-				SectionToPlay = FName("LeftArm");
-				LeftArmHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-				bEnableLeftArmProfile = true;
-			}
-			break;
+	case EBoneHitReactValue::EBHR_LeftLeg:
+		LimbHitCounter = &LeftLegHitCounter;
+		if (bFromFront) { LimbProfile = &bEnableLeftLegProfile; }
+		break;
 
-		case EBoneHitReactValue::EBHR_LeftLeg:
-			LeftLegHitCounter++;
-			if (LeftLegHitCounter >= 2)
-			{
-				MontageToPlay = HitReactsLimbs;
-				SectionToPlay = FName("LeftLeg");
-				LeftLegHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-				bEnableLeftLegProfile = true;
-			}
-			break;
+	case EBoneHitReactValue::EBHR_RightLeg:
+		LimbHitCounter = &RightLegHitCounter;
+		if (bFromFront) { LimbProfile = &bEnableRightLegProfile; }
+		break;
 
-		case EBoneHitReactValue::EBHR_RightArm:
-			RightArmHitCounter++;
-			if (RightArmHitCounter >= 2)
-			{
-				SectionToPlay = FName("RightArm");
-				RightArmHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-				bEnableRightArmProfile = true;	
-			}
-			break;
+	default:
+		break;
+	}
 
-		case EBoneHitReactValue::EBHR_RightLeg:
-			RightLegHitCounter++;
-			if (RightLegHitCounter >= 2)
-			{
-				MontageToPlay = HitReactsLimbs;
-				SectionToPlay = FName("RightLeg");
-				RightLegHitCounter = 0;
-				EnemyController->StopMovement();
-			}
-			else
-			{
-				MontageToPlay = HitReactsTorso;
-				SectionToPlay = GetTorsoHitReactSectionName(LastHitDirection);
-				bShouldPlayPhysicalHitReact = true;
-				bEnableLeftLegProfile = true;
-			}
-			break;
-		}
+	// every 2nd hit to a limb plays that limb's react
+	if (LimbHitCounter && ++(*LimbHitCounter) >= 2)
+	{
+		*LimbHitCounter = 0;
+		EnemyController->StopMovement();
+		return HitReacts.GetLimbReact(LastBoneHitReact, bIncapacitated);
 	}
 
-	FHitReact HitReactData;
-	HitReactData.MontageToPlay = MontageToPlay;
-	HitReactData.SectionToPlay = SectionToPlay;
+	// otherwise (and for the torso) play appropriate directional torso anim, with a physical hit react on top
+	bShouldPlayPhysicalHitReact = true;
+	if (LimbProfile) { *LimbProfile = true; }
 
-	return HitReactData;
+	return HitReacts.GetTorsoReact(LastHitDirection, bIncapacitated);
 }
 
 void AEnemy::PlayRandomSpeechCue()
@@ -862,16 +1330,26 @@ void AEnemy::PlayRandomSpeechCue()
 	if (RandomSpeechCueToPlay != nullptr)
 	{
 		// interrupt any relevant audio (playing or pending play; attack cue played on AnimNotify from BP);
-		if (ActiveSpeechAudio != nullptr) { ActiveSpeechAudio->Stop(); }
+		StopSpeechAudio();
 		if (ActiveCrawlingAudio != nullptr) { ActiveCrawlingAudio->Stop(); }
 		ClearIdleSpeechCueTimer();
-		GetWorldTimerManager().ClearTimer(ChasingCue_TimerHandle);
+		ClearEnemyTimer(EEnemyTimer::ET_ChasingCue);
+
+		// play sound cue on a pooled voice; chasing beats idle, hurt/death beat both
+		UAudioVoiceSubsystem* VoicePool = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+		if (VoicePool == nullptr) { return; }
 
-		// play sound cue
-		ActiveSpeechAudio = UGameplayStatics::SpawnSoundAttached(RandomSpeechCueToPlay, GetRootComponent());
+		EAudioVoicePriority Priority = EAudioVoicePriority::AVP_High;
+		if (RandomSpeechCueToPlay == GetArchetype().RandomIdleCue) { Priority = EAudioVoicePriority::AVP_Low; }
+		else if (RandomSpeechCueToPlay == GetArchetype().RandomChasingCue) { Priority = EAudioVoicePriority::AVP_Medium; }
+
+		SpeechVoice = VoicePool->PlaySoundAttached(RandomSpeechCueToPlay, GetRootComponent(), Priority);
+
+		// over the voice budget; stay quiet (and keep the mouth shut)
+		if (VoicePool->GetVoiceComponent(SpeechVoice) == nullptr) { return; }
 		
 		// make value for close mouth timer
-		float SpeechDuration = ActiveSpeechAudio->GetSound()->GetDuration();
+		float SpeechDuration = RandomSpeechCueToPlay->GetDuration();
 		SpeechDuration -= 1.5f;
 		if (SpeechDuration <= 1.5f) { SpeechDuration = 1.5f; }
 
@@ -879,42 +1357,58 @@ void AEnemy::PlayRandomSpeechCue()
 		OpenMouth();
 
 		// clear any existing + set close mouth timer
-		GetWorldTimerManager().ClearTimer(CloseMouth_TimerHandle);
-		GetWorldTimerManager().SetTimer(CloseMouth_TimerHandle, this, &AEnemy::CloseMouth, SpeechDuration);
+		ClearEnemyTimer(EEnemyTimer::ET_CloseMouth);
+		SetEnemyTimer(EEnemyTimer::ET_CloseMouth, &AEnemy::CloseMouth, SpeechDuration);
+	}
+}
+
+UAudioComponent* AEnemy::GetSpeechAudio() const
+{
+	const UAudioVoiceSubsystem* VoicePool = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+	if (UAudioComponent* PooledSpeech = VoicePool ? VoicePool->GetVoiceComponent(SpeechVoice) : nullptr)
+	{ return PooledSpeech; }
+
+	return ActiveSpeechAudio;
+}
+
+void AEnemy::StopSpeechAudio()
+{
+	if (UAudioVoiceSubsystem* VoicePool = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>())
+	{ VoicePool->StopVoice(SpeechVoice); }
+
+	SpeechVoice.Reset();
+
+	// BP-spawned speech isn't pooled; stop it directly
+	if (ActiveSpeechAudio != nullptr)
+	{
+		ActiveSpeechAudio->Stop();
+		ActiveSpeechAudio = nullptr;
 	}
 }
 
 void AEnemy::ClearIdleSpeechCueTimer()
 {
-	GetWorldTimerManager().ClearTimer(IdleCue_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_IdleCue);
 }
 
 void AEnemy::ClearChasingSpeechCueTimer()
 {
-	GetWorldTimerManager().ClearTimer(ChasingCue_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_ChasingCue);
 }	
 
 void AEnemy::HandleIdleState()
 {
 	// periodically play random idle speech
-	if (!GetWorldTimerManager().IsTimerActive(IdleCue_TimerHandle) && bCanPlayIdleSpeech)
+	if (!IsEnemyTimerActive(EEnemyTimer::ET_IdleCue) && bCanPlayIdleSpeech)
 	{
-		float IdleCueInterval = FMath::RandRange(IdleCueIntervalMin, IdleCueIntervalMax);
+		float IdleCueInterval = FMath::RandRange(GetArchetype().IdleCueIntervalMin, GetArchetype().IdleCueIntervalMax);
 		float Deviation = FMath::RandRange(-2.f, 2.f);
 
-		if (ActiveSpeechAudio != nullptr)
-		{
-			if (!ActiveSpeechAudio->IsPlaying())
-
-			{
-				RandomSpeechCueToPlay = RandomIdleCue;
-				GetWorldTimerManager().SetTimer(IdleCue_TimerHandle, this, &AEnemy::PlayRandomSpeechCue, IdleCueInterval + Deviation);
-			}
-		}
-		else
+		const UAudioComponent* SpeechAudio = GetSpeechAudio();
+		if (SpeechAudio == nullptr || !SpeechAudio->IsPlaying())
 		{
-			RandomSpeechCueToPlay = RandomIdleCue;
-			GetWorldTimerManager().SetTimer(IdleCue_TimerHandle, this, &AEnemy::PlayRandomSpeechCue, IdleCueInterval + Deviation);
+			RandomSpeechCueToPlay = GetArchetype().RandomIdleCue;
+			SetEnemyTimer(EEnemyTimer::ET_IdleCue, &AEnemy::PlayRandomSpeechCue, IdleCueInterval + Deviation);
 		}
 	}
 }
@@ -930,97 +1424,58 @@ void AEnemy::HandlePatrollingState()
 void AEnemy::HandleChasingState()
 {
 	// periodically play random chasing speech
-	if (!GetWorldTimerManager().IsTimerActive(ChasingCue_TimerHandle))
+	if (!IsEnemyTimerActive(EEnemyTimer::ET_ChasingCue))
 	{
-		float ChasingCueInterval = FMath::RandRange(ChasingCueIntervalMin, ChasingCueIntervalMax);
+		float ChasingCueInterval = FMath::RandRange(GetArchetype().ChasingCueIntervalMin, GetArchetype().ChasingCueIntervalMax);
 		float Deviation = FMath::RandRange(-1.f, 1.f);
 
-		if (ActiveSpeechAudio != nullptr)
+		const UAudioComponent* SpeechAudio = GetSpeechAudio();
+		if (SpeechAudio == nullptr || !SpeechAudio->IsPlaying())
 		{
-			if (!ActiveSpeechAudio->IsPlaying())
-			{
-				RandomSpeechCueToPlay = RandomChasingCue;
-				GetWorldTimerManager().SetTimer(ChasingCue_TimerHandle, this, &AEnemy::PlayRandomSpeechCue, ChasingCueInterval + Deviation);
-			}
-		}
-		else
-		{
-			RandomSpeechCueToPlay = RandomChasingCue;
-			GetWorldTimerManager().SetTimer(ChasingCue_TimerHandle, this, &AEnemy::PlayRandomSpeechCue, ChasingCueInterval + Deviation);
+			RandomSpeechCueToPlay = GetArchetype().RandomChasingCue;
+			SetEnemyTimer(EEnemyTimer::ET_ChasingCue, &AEnemy::PlayRandomSpeechCue, ChasingCueInterval + Deviation);
 		}
 	}
 }
 
 
-void AEnemy::PlayMontageSection(UAnimMontage* Montage, const FName& SectionName)
+const FEnemyMontageTable& AEnemy::GetMontageTable()
 {
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance && Montage)
-	{
-		AnimInstance->Montage_Play(Montage);
-		AnimInstance->Montage_JumpToSection(SectionName, Montage);
-	}
+	return GetArchetype().GetMontageTable();
 }
 
 
-int32 AEnemy::PlayRandomMontageSection(UAnimMontage* Montage, const TArray<FName>& SectionNames)
+float AEnemy::PlayRandomMontageSection(const FMontageSectionList& SectionList)
 {
-	if (SectionNames.Num() <= 0) { return -1; }
-
-	const int32 MaxSectionIndex = SectionNames.Num() - 1;
-	const int32 Selection = FMath::RandRange(0, MaxSectionIndex);
-	PlayMontageSection(Montage, SectionNames[Selection]);
-	return Selection;
+	const FMontageSection* Section = SectionList.PickRandom();
+	return Section ? Section->Play(GetMesh()->GetAnimInstance()) : 0.f;
 }
 
 float AEnemy::PlayAttackMontage()
 {
-	int32 Selection;
-	float AnimDuration;
-
-	if (bIncapacitated)
-	{
-		Selection = PlayRandomMontageSection(CrawlingAttackMontage, CrawlingAttackMontageSections);
-		AnimDuration = CrawlingAttackMontage->GetSectionLength(Selection);
-	}
-
-	else
-	{
-		Selection = PlayRandomMontageSection(AttackCloseMontage, AttackCloseMontageSections);
-		AnimDuration = AttackCloseMontage->GetSectionLength(Selection);
-	}
-
-	return AnimDuration;
+	const FEnemyMontageTable& Montages = GetMontageTable();
+	return PlayRandomMontageSection(bIncapacitated ? Montages.CrawlingAttack : Montages.AttackClose);
 }
 
 
 float AEnemy::PlayLungeAttackMontage()
 {
-	int32 Selection;
-	float AnimDuration;
-
-	Selection = PlayRandomMontageSection(AttackDistanceMontage, AttackDistanceMontageSections);
-	AnimDuration = AttackDistanceMontage->GetSectionLength(Selection);
-
-	return AnimDuration;
+	return PlayRandomMontageSection(GetMontageTable().AttackDistance);
 }
 
 
 float AEnemy::PlayDeathMontage()
 {
 	// play appropriate death anim + update death pose to match
-	int32 Selection;
-	float AnimDuration;
-
-	Selection = PlayRandomMontageSection(DeathMontage, DeathMontageBackwardOnlySections);
-	AnimDuration = PlayAnimMontage(DeathFallBackwardsMontage);
+	PlayRandomMontageSection(GetMontageTable().DeathBackward);
+	float AnimDuration = PlayAnimMontage(GetArchetype().DeathFallBackwardsMontage);
 
 	return AnimDuration;
 }
 
 void AEnemy::LoseInterestInPlayer()
 {
-	if (AwarenessLevel == EEnemyAwarenessLevel::EAL_Passive) { return; }
+	if (GetEnemyAwarenessLevel() == EEnemyAwarenessLevel::EAL_Passive) { return; }
 	bCanLookAtPlayer = false;
 	CombatTarget = nullptr;
 	EnemyController->SetFocus(NULL);
@@ -1032,7 +1487,7 @@ void AEnemy::LoseInterestInPlayer()
 	if (CanPatrol()) { StartPatrolling(); }
 
 	else // wander away after brief delay
-	{ GetWorldTimerManager().SetTimer(WanderDelay_TimerHandle, this, &AEnemy::WanderAway, 2.f); }
+	{ SetEnemyTimer(EEnemyTimer::ET_WanderDelay, &AEnemy::WanderAway, 2.f); }
 }
 
 
@@ -1040,7 +1495,7 @@ void AEnemy::StartPatrolling()
 {
 	SetEnemyCombatState(EEnemyCombatState::ECS_Patrolling);
 	EnemyController->SetFocus(PatrolTarget);
-	GetWorldTimerManager().SetTimer(RotateTowards_TimerHandle, this, &AEnemy::MoveToCurrentPatrolTarget, PassiveRotateTowardsDelay);
+	SetEnemyTimer(EEnemyTimer::ET_RotateTowards, &AEnemy::MoveToCurrentPatrolTarget, GetArchetype().PassiveRotateTowardsDelay);
 }
 
 void AEnemy::ChasePlayer()
@@ -1054,19 +1509,19 @@ void AEnemy::RotateTowardsThenChasePlayer()
 {
 	SetEnemyCombatState(EEnemyCombatState::ECS_Chasing);
 	EnemyController->SetFocus(CombatTarget);
-	GetWorldTimerManager().SetTimer(RotateTowards_TimerHandle, this, &AEnemy::MoveToCurrentCombatTarget, HostileRotateTowardsDelay);
+	SetEnemyTimer(EEnemyTimer::ET_RotateTowards, &AEnemy::MoveToCurrentCombatTarget, GetArchetype().HostileRotateTowardsDelay);
 }
 
 
 bool AEnemy::CanAttack()
 {
-	return IsPlayerInsideAttackRange() && !IsEnemyAttacking() && !IsEnemyEngaged() && bAlive && IsFacingPlayer();
+	return IsPlayerInsideAttackRange() && !IsEnemyAttacking() && !IsEnemyEngaged() && GetAlive() && IsFacingPlayer();
 }
 
 
 bool AEnemy::CanLungeAttack()
 {
-	return !IsPlayerInsideAttackRange() && IsPlayerInsideLungeAttackRange() && !bIncapacitated && !IsEnemyAttacking() && !IsEnemyEngaged() && bAlive && IsFacingPlayer();
+	return !IsPlayerInsideAttackRange() && IsPlayerInsideLungeAttackRange() && !bIncapacitated && !IsEnemyAttacking() && !IsEnemyEngaged() && GetAlive() && IsFacingPlayer();
 }
 
 
@@ -1081,8 +1536,8 @@ void AEnemy::Attack()
 	SetEnemyCombatState(EEnemyCombatState::ECS_Engaged);
 	float AnimDuration = PlayAttackMontage();
 	float LoseTrackingDelay = AnimDuration * .75f;
-	GetWorldTimerManager().SetTimer(LoseTracking_TimerHandle, this, &AEnemy::LosePlayerTracking, LoseTrackingDelay);
-	GetWorldTimerManager().SetTimer(Attacking_TimerHandle, this, &AEnemy::AttackEnd, AnimDuration);
+	SetEnemyTimer(EEnemyTimer::ET_LoseTracking, &AEnemy::LosePlayerTracking, LoseTrackingDelay);
+	SetEnemyTimer(EEnemyTimer::ET_Attacking, &AEnemy::AttackEnd, AnimDuration);
 }
 
 
@@ -1097,8 +1552,8 @@ void AEnemy::LungeAttack()
 	SetEnemyCombatState(EEnemyCombatState::ECS_Engaged);
 	float AnimDuration = PlayLungeAttackMontage();
 	float LoseTrackingDelay = AnimDuration * .75f;
-	GetWorldTimerManager().SetTimer(LoseTracking_TimerHandle, this, &AEnemy::LosePlayerTracking, LoseTrackingDelay);
-	GetWorldTimerManager().SetTimer(Attacking_TimerHandle, this, &AEnemy::AttackEnd, AnimDuration);
+	SetEnemyTimer(EEnemyTimer::ET_LoseTracking, &AEnemy::LosePlayerTracking, LoseTrackingDelay);
+	SetEnemyTimer(EEnemyTimer::ET_Attacking, &AEnemy::AttackEnd, AnimDuration);
 }
 
 
@@ -1113,14 +1568,14 @@ void AEnemy::AttackEnd()
 
 void AEnemy::StartAttackTimer()
 {
-	const float AttackDelay = FMath::RandRange(AttackDelayMin, AttackDelayMax);
-	GetWorldTimerManager().SetTimer(AttackTimer_TimerHandle, this, &AEnemy::Attack, AttackDelay);
+	const float AttackDelay = FMath::RandRange(GetArchetype().AttackDelayMin, GetArchetype().AttackDelayMax);
+	SetEnemyTimer(EEnemyTimer::ET_AttackTimer, &AEnemy::Attack, AttackDelay);
 }
 
 
 void AEnemy::ClearAttackTimer()
 {
-	GetWorldTimerManager().ClearTimer(AttackTimer_TimerHandle);
+	ClearEnemyTimer(EEnemyTimer::ET_AttackTimer);
 }
 
 
@@ -1207,47 +1662,27 @@ void AEnemy::CheckPlayerLOS()
 
 	LastPlayerLOSCheckTime = GetWorld()->GetTimeSeconds();
 
-	FHitResult HitResult;
-	FVector TraceStart = GetActorLocation();
-	FVector TraceEnd = CombatTarget->GetActorLocation();
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECollisionChannel::ECC_Visibility, QueryParams);
-	
-	bCanSeePlayer = !bHit;
+	// batched + traced asynchronously by the perception subsystem
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{ Perception->RequestPlayerLOS(this); }
 }
 
 
-void AEnemy::LoseTarget()
+// called by the perception subsystem once the async LOS trace has completed
+void AEnemy::OnPlayerLOSResolved(bool bHasLOS)
 {
-	if (bCanSeePlayer) { return; }
+	bCanSeePlayer = bHasLOS && CombatTarget != nullptr;
 
-	LoseInterestInPlayer();
+	if (!GetAlive() || !HasCombatTarget()) { return; }
+
+	if (!bCanSeePlayer && IsEnemyTimerActive(EEnemyTimer::ET_TargetLoss) == false)
+	{ SetEnemyTimer(EEnemyTimer::ET_TargetLoss, &AEnemy::LoseTarget, GetArchetype().TargetLossDelay); }
 }
 
-FName AEnemy::GetTorsoHitReactSectionName(ELastHitDirection LastHitDirection)
-{
-	FName SectionToPlay;
-	switch (LastHitDirection)
-	{
-	case ELastHitDirection::ELHD_Front:
-		SectionToPlay = FName("FromFront");
-		break;
-	case ELastHitDirection::ELHD_Back:
-		SectionToPlay = FName("FromBack");
-		break;
-	case ELastHitDirection::ELHD_Left:
-		SectionToPlay = FName("FromLeft");
-		break;
-	case ELastHitDirection::ELHD_Right:
-		SectionToPlay = FName("FromRight");
-		break;
 
-	default:
-		SectionToPlay = FName("FromFront");
-		break;
-	}
+void AEnemy::LoseTarget()
+{
+	if (bCanSeePlayer) { return; }
 
-	return SectionToPlay;
+	LoseInterestInPlayer();
 }
\ No newline at end of file
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "../DebugMacros.h"
+#include "../Effects/AudioVoiceSubsystem.h"
 #include "Enemy.generated.h"
 
 class UNiagaraSystem;
+class UEnemyArchetype;
 
 UENUM(BlueprintType)
 enum class EEnemyAwarenessLevel : uint8
@@ -46,6 +48,14 @@ enum class EBoneHitReactValue : uint8
 	EBHR_MAX		UMETA(DisplayName = "DefaultMAX")
 };
 
+// compiled bone -> value lookup (see UHitZoneSubsystem)
+template<typename ValueType> struct THitZoneTable;
+
+// montage sections resolved to indices (see MontageSectionTable.h)
+struct FMontageSection;
+struct FMontageSectionList;
+struct FEnemyMontageTable;
+
 UENUM(BlueprintType)
 enum class ELastHitDirection : uint8
 {
@@ -57,15 +67,6 @@ enum class ELastHitDirection : uint8
 	ELHD_MAX		UMETA(DisplayName = "DefaultMAX")
 };
 
-USTRUCT(BlueprintType)
-struct FHitReact
-{
-	GENERATED_BODY()
-
-	UAnimMontage* MontageToPlay;
-	FName SectionToPlay;
-};
-
 UENUM(BlueprintType)
 enum EDeathPose
 {
@@ -76,6 +77,37 @@ enum EDeathPose
 	EDP_MAX			UMETA(DisplayName = "DefaultMAX")
 };
 
+// what FEnemyStateStore's decision pass wants a hostile enemy to do next; anything needing the actor (facing, montages) is left to Evaluate
+enum class EEnemyHostileDecision : uint8
+{
+	EHD_None,				// not hostile / no target
+	EHD_LoseInterest,		// target dead or outside combat radius
+	EHD_Chase,				// target out of (lunge) attack range and not already chasing
+	EHD_Evaluate			// in range or already chasing; actor decides between chasing / attacking
+};
+
+// fixed set of per-enemy AI timers, run on the UEnemyTickManager's timer wheel (see FEnemyTimerWheel)
+enum class EEnemyTimer : uint8
+{
+	ET_Patrol,
+	ET_RotateTowards,
+	ET_TargetLoss,
+	ET_WanderDelay,
+	ET_AttackTimer,
+	ET_Attacking,
+	ET_TakeDamage,
+	ET_HitReact,
+	ET_AggroAfterHit,
+	ET_DeathEnd,
+	ET_LoseTracking,
+	ET_IdleCue,
+	ET_ChasingCue,
+	ET_CloseMouth,
+	ET_FinalizeCorpse,
+
+	ET_MAX
+};
+
 
 UCLASS()
 class ESCAPEROOMPROJECT_API AEnemy : public ACharacter
@@ -89,9 +121,6 @@ public:
 
 	class AEnemyController* EnemyController;
 
-	UPROPERTY(VisibleAnywhere)
-	class UPawnSensingComponent* PawnSensingComp;
-
 	UPROPERTY(EditAnywhere, Category = "Behavior Tree", meta = (AllowPrivateAccess = "true"))
 	class UBehaviorTree* BehaviorTree;
 
@@ -104,40 +133,76 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spawning")
 	FVector SpawnLocation;
 
+	// shared per-type designer data (stats, perception, combat tuning, montages, bone map, FX, speech), read straight from
+	// there at runtime (see GetArchetype). required: an enemy without one fails data validation
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	class UEnemyArchetype* Archetype;
+
+	// Archetype, or a read-only fallback if it is missing anyway (the legacy values in the editor, class defaults in a cooked build)
+	const UEnemyArchetype& GetArchetype() const;
+
+	// start this enemy off with its archetype's health, speeds and ranges
+	void ApplyArchetype();
+
+#if WITH_EDITOR
+	// move this enemy's legacy designer values (below) onto a new archetype asset next to it, and point it there
+	UFUNCTION(CallInEditor, Category = "Config")
+	void MigrateToArchetype();
+
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+	// set while this enemy sits dormant in the UEnemyPoolSubsystem (hidden, no collision, not updated)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawning")
+	bool bInEnemyPool;
+
+	// this enemy's slot in the UEnemyTickManager's hot state store (set by the manager; null when unmanaged). while set,
+	// the slot holds this enemy's awareness level, combat state, alive flag and attack range
+	struct FEnemyStateStore* StateStore;
+
+	int32 StateIndex;
+
 	/*
-	*  movement and rotation speeds, awareness levels, combat states
+	*  AI timers (timer wheel slots, allocated on first use)
 	*/
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	float PassiveWalkSpeed;
+	void SetEnemyTimer(EEnemyTimer Timer, void (AEnemy::*Callback)(), float Delay);
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	float HostileWalkSpeed;
+	void ClearEnemyTimer(EEnemyTimer Timer);
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	FRotator PassiveRotationRate;
+	bool IsEnemyTimerActive(EEnemyTimer Timer) const;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	FRotator HostileRotationRate;
+	void ClearAllEnemyTimers();
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	FRotator IncapacitatedRotationRate;
+	class FEnemyTimerWheel* TimerWheel;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-	EEnemyAwarenessLevel AwarenessLevel;
+	int32 TimerBlock;
+
+	// mesh/capsule state captured on BeginPlay, restored when recycled
+	FName DefaultMeshCollisionProfile;
+
+	FCollisionResponseContainer DefaultMeshCollisionResponses;
+
+	FTransform DefaultMeshRelativeTransform;
+
+	/*
+	*  awareness levels, combat states
+	*/
+
+	// awareness level, combat state, alive and attack range live in this enemy's state store slot while it is managed
+	// (see StateStore); always read + write them through these
 
 	UFUNCTION(BlueprintCallable)
 	void SetEnemyAwarenessLevel(EEnemyAwarenessLevel NewAwarenessLevel);
 
-	FORCEINLINE EEnemyAwarenessLevel GetEnemyAwarenessLevel() { return AwarenessLevel; }
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-	EEnemyCombatState CombatState;
+	UFUNCTION(BlueprintGetter)
+	EEnemyAwarenessLevel GetEnemyAwarenessLevel() const;
 
 	UFUNCTION(BlueprintCallable)
 	void SetEnemyCombatState(EEnemyCombatState NewCombatState);
 
-	FORCEINLINE EEnemyCombatState GetEnemyCombatState() { return CombatState; }
+	UFUNCTION(BlueprintGetter)
+	EEnemyCombatState GetEnemyCombatState() const;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
 	EEnemyCombatState PreviousCombatState;
@@ -149,42 +214,31 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
 	float Health;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	float MaxHealth;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	float Damage;
+	UFUNCTION(BlueprintSetter)
+	void SetAlive(bool bNewAlive);
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-	bool bAlive;
+	UFUNCTION(BlueprintGetter)
+	bool GetAlive() const;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
 	bool bIsRagdoll;
 
-	FTimerHandle StartRagdoll_TimerHandle;
+	// ragdoll came to rest (or was evicted from the physics budget) and is now a static posed mesh
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
+	bool bRagdollFrozen;
+
+	// dead + settled; animation, skinning updates, overlaps and AI are shut down (see FinalizeCorpse)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
+	bool bCorpseFinalized;
+
+	// how often a non-ragdoll corpse checks whether its death anim has finished
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+	float CorpseSettleCheckInterval;
 
 	/*
 	*	perception variables
 	*/
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float PeripheralVisionAngle;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float PerceptionRange;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float VisionRange;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float VisionAggroRange;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float HearingAggroRange;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
-	float TargetLossDelay;
-
 	class APlayerCharacter* PlayerCharacter;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
@@ -194,8 +248,6 @@ public:
 
 	float PlayerLOSCheckFrequency;
 
-	FTimerHandle TargetLoss_TimerHandle;
-
 	/*
 	*	navigation variables
 	*/
@@ -208,25 +260,6 @@ public:
 	UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category = "AI Navigation")
 	TArray<AActor*> PatrolTargets;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
-	float PatrolAcceptanceRadius;
-
-	FTimerHandle Patrol_TimerHandle;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
-	float PatrolIdleTimeMin;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
-	float PatrolIdleTimeMax;
-
-	FTimerHandle RotateTowards_TimerHandle;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
-	float PassiveRotateTowardsDelay;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
-	float HostileRotateTowardsDelay;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	int32 LeftLegHitCounter;
 
@@ -265,8 +298,6 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Navigation")
 	bool bNeedsExtraVerticalOffsetWhenDown;
 
-	FTimerHandle WanderDelay_TimerHandle;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI Navigation")
 	bool bCanSeePlayer;
 
@@ -277,28 +308,16 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
 	AActor* CombatTarget;
 
-	// maximum distance in which to remain hostile
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float CombatRadius;
-
-	// maximum distance in which to initiate an attack
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float AttackRange;
-
-	// maximum distance in which to initiate a lunge attack
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float LungeAttackRange;
+	// maximum distance in which to initiate an attack (the archetype's standing or crawling range)
+	void SetAttackRange(float NewAttackRange);
 
-	// maximum distance in which to initiate an attack while incapacitated
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float CrawlingAttackRange;
+	UFUNCTION(BlueprintGetter)
+	float GetAttackRange() const;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+	// the archetype's standing or crawling move-to acceptance radius
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Combat")
 	float MoveToAcceptanceRadius;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float CrawlingMoveToAcceptanceRadius;
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	bool bStaggered;
 
@@ -311,49 +330,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	bool bInAttackRange;
 
-	// new attack timer stuff
-	FTimerHandle AttackTimer_TimerHandle;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float AttackDelayMin;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-	float AttackDelayMax;
-
-	// old, deprecated attack timer stuff
-	FTimerHandle Attacking_TimerHandle;
-
-	FTimerHandle AttackDelay_TimerHandle;
-
-	FTimerHandle TakeDamage_TimerHandle;
-
-	UPROPERTY(EditAnywhere, Category = "Combat")
-	float TakeDamageDelay;
-
-	UPROPERTY(EditAnywhere, Category = "Combat")
-	TSubclassOf<UDamageType> DamageTypeClass;
-
-	// a map of bone -> hit react enum
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	TMap<FName, EBoneHitReactValue> BoneHitReactMap;
-
-	FTimerHandle HitReact_TimerHandle;
-
-	FTimerHandle AggroAfterHit_TimerHandle;
-
 	bool bShouldPlayPhysicalHitReact;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	float TorsoPhysicalHitReactStrength;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	float HeadPhysicalHitReactStrength;
+	bool bLastHitWasLimb;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	float ArmPhysicalHitReactStrength;
+	// this enemy's blueprint implements Event Tick, so its actor tick has to stay on (checked on BeginPlay)
+	bool bBlueprintTicks;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	float LegPhysicalHitReactStrength;
+	// the archetype's BoneHitReactMap, registered with UHitZoneSubsystem in ApplyArchetype
+	int32 HitReactMapId;
 
-	bool bLastHitWasLimb;
+	// that map compiled against the body mesh (built up front in BuildHitZones; other meshes are looked up when hit)
+	TSharedPtr<const THitZoneTable<EBoneHitReactValue>> HitReactZones;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	FHitResult LastHitResult;
@@ -368,138 +356,224 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Combat")
 	TEnumAsByte<EDeathPose> DeathPose;
 
-	FTimerHandle DeathEnd_TimerHandle;
+	/*
+	*  sound FX
+	*/
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	bool bCanPlayIdleSpeech;
+	
+	// speech spawned from BP (e.g., attack cues on AnimNotify); never a pooled voice (those are only reached through SpeechVoice)
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "SFX")
+	class UAudioComponent* ActiveSpeechAudio;
 
-	FTimerHandle LoseTracking_TimerHandle;
+	FAudioVoiceHandle SpeechVoice;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	class UAudioComponent* ActiveCrawlingAudio;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	class USoundBase* RandomSpeechCueToPlay;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	bool bMouthOpen;
+
+#if WITH_EDITORONLY_DATA
 	/*
-	*  combat anims
+	*  legacy designer data, from before enemy archetypes. not edited or read at runtime any more; only still loaded from
+	*  older blueprints/levels so MigrateToArchetype can move it onto an archetype (same names as UEnemyArchetype's)
 	*/
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
+	float PassiveWalkSpeed;
+
+	UPROPERTY()
+	float HostileWalkSpeed;
+
+	UPROPERTY()
+	FRotator PassiveRotationRate;
+
+	UPROPERTY()
+	FRotator HostileRotationRate;
+
+	UPROPERTY()
+	FRotator IncapacitatedRotationRate;
+
+	UPROPERTY()
+	float MaxHealth;
+
+	UPROPERTY()
+	float Damage;
+
+	UPROPERTY()
+	float PeripheralVisionAngle;
+
+	UPROPERTY()
+	float PerceptionRange;
+
+	UPROPERTY()
+	float VisionRange;
+
+	UPROPERTY()
+	float VisionAggroRange;
+
+	UPROPERTY()
+	float HearingAggroRange;
+
+	UPROPERTY()
+	float TargetLossDelay;
+
+	UPROPERTY()
+	float PatrolAcceptanceRadius;
+
+	UPROPERTY()
+	float PatrolIdleTimeMin;
+
+	UPROPERTY()
+	float PatrolIdleTimeMax;
+
+	UPROPERTY()
+	float PassiveRotateTowardsDelay;
+
+	UPROPERTY()
+	float HostileRotateTowardsDelay;
+
+	UPROPERTY()
+	float CombatRadius;
+
+	UPROPERTY()
+	float LungeAttackRange;
+
+	UPROPERTY()
+	float CrawlingAttackRange;
+
+	UPROPERTY()
+	float CrawlingMoveToAcceptanceRadius;
+
+	UPROPERTY()
+	float AttackDelayMin;
+
+	UPROPERTY()
+	float AttackDelayMax;
+
+	UPROPERTY()
+	float TakeDamageDelay;
+
+	UPROPERTY()
+	TSubclassOf<UDamageType> DamageTypeClass;
+
+	UPROPERTY()
+	TMap<FName, EBoneHitReactValue> BoneHitReactMap;
+
+	UPROPERTY()
+	float TorsoPhysicalHitReactStrength;
+
+	UPROPERTY()
+	float HeadPhysicalHitReactStrength;
+
+	UPROPERTY()
+	float ArmPhysicalHitReactStrength;
+
+	UPROPERTY()
+	float LegPhysicalHitReactStrength;
+
+	UPROPERTY()
 	UAnimMontage* HitReactsTorso;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* HitReactsLimbs;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* HitReactsCrawling;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* AttackCloseMontage;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> AttackCloseMontageSections;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* AttackDistanceMontage;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> AttackDistanceMontageSections;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* CrawlingAttackMontage;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> CrawlingAttackMontageSections;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* DeathMontage;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> DeathMontageAllSections;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> DeathMontageBackwardOnlySections;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> DeathMontageForwardOnlySections;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* DeathDirectionalMontage;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* DeathFallBackwardsMontage;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* DeathFallForwardsMontage;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	UPROPERTY()
 	UAnimMontage* CrawlingDeathMontage;
 
-	UPROPERTY(EditAnywhere, Category = "Combat")
+	UPROPERTY()
 	TArray<FName> CrawlingDeathMontageSections;
 
-	/*
-	*  combat FX
-	*/
-
-	// FX for blood impact particles (spawned on bullet impact)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
+	UPROPERTY()
 	UNiagaraSystem* BloodImpactParticles1;
 
-	// FX for blood impact particles (spawned on bullet impact)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
+	UPROPERTY()
 	UNiagaraSystem* BloodImpactParticles2;
 
-	// FX for blood pooling (spawned underneath enemy after death)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
+	UPROPERTY()
 	UNiagaraSystem* BloodPool;
 
-	/*
-	*  sound FX
-	*/
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
-	bool bCanPlayIdleSpeech;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
-	class UAudioComponent* ActiveSpeechAudio;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
-	class UAudioComponent* ActiveCrawlingAudio;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
-	class USoundBase* RandomSpeechCueToPlay;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundBase* RandomIdleCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundCue* RandomChasingCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundCue* RandomHurtCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundCue* RandomDeathCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundCue* RandomAttackShortCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	class USoundCue* RandomAttackLongCue;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	float IdleCueIntervalMin;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	float IdleCueIntervalMax;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	float ChasingCueIntervalMin;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
+	UPROPERTY()
 	float ChasingCueIntervalMax;
 
-	FTimerHandle IdleCue_TimerHandle;
-
-	FTimerHandle ChasingCue_TimerHandle;
-
-	FTimerHandle CloseMouth_TimerHandle;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SFX")
-	bool bMouthOpen;
+	// built from the legacy data for enemies without an archetype, so they still play as authored in the editor
+	UPROPERTY(Transient)
+	mutable UEnemyArchetype* LegacyArchetype;
+#endif
 
 
 protected:
@@ -507,15 +581,26 @@ protected:
 	// called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 
-	// called every frame
+	// called every frame (only enabled while incapacitated or when the blueprint implements Event Tick; AI is updated by UEnemyTickManager)
 	virtual void Tick(float DeltaTime) override;
 
+	// actor tick on only while something needs it: the crawling offset (see SetIncapacitated) or the blueprint's Event Tick
+	void RefreshActorTickEnabled();
+
+	// awareness-level state handling; called by UEnemyTickManager at this enemy's update rate
+	void UpdateEnemyAI(float DeltaTime);
+
+	// result of a CheckPlayerLOS request, delivered by UEnemyPerceptionSubsystem the frame after it was made
+	void OnPlayerLOSResolved(bool bHasLOS);
+
 	void DetermineCombatState();
 
 	UFUNCTION(BlueprintCallable)
-	FORCEINLINE bool IsAlive() { return ( bAlive && CombatState != EEnemyCombatState::ECS_Dead); }
+	FORCEINLINE bool IsAlive() { return ( GetAlive() && GetEnemyCombatState() != EEnemyCombatState::ECS_Dead); }
 
 	UFUNCTION()
 	void CombatRangeSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -531,7 +616,8 @@ public:
 
 	void HandlePassiveStates();
 
-	void HandleHostileStates();
+	// bFromStatePass: called from the tick manager's update, so this frame's state store decision is current
+	void HandleHostileStates(bool bFromStatePass = false);
 
 	void HandleIdleState();
 
@@ -546,6 +632,13 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void PlayRandomSpeechCue();
 
+	// the component playing this enemy's speech: its pooled voice while SpeechVoice still owns it (not once finished, or
+	// stolen by a higher priority sound), else any BP-spawned speech
+	UFUNCTION(BlueprintPure, Category = "SFX")
+	UAudioComponent* GetSpeechAudio() const;
+
+	void StopSpeechAudio();
+
 	void ClearIdleSpeechCueTimer();
 
 	void ClearChasingSpeechCueTimer();
@@ -577,13 +670,11 @@ public:
 	void ClearAggroAfterHitTimer();
 
 	/*
-	*  perception
+	*  perception (called by UEnemyPerceptionSubsystem when what this enemy perceives changes)
 	*/
 
-	UFUNCTION()
 	void PawnSeen(APawn* SeenPawn);
 
-	UFUNCTION()
 	void PawnHeard(APawn* HeardPawn);
 
 	/*
@@ -620,9 +711,16 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void DeathEnd();
 
+	// simulates a ragdoll if the URagdollBudgetSubsystem grants a slot
 	UFUNCTION(BlueprintCallable)
 	void StartRagdoll();
 
+	void FreezeRagdoll();
+
+	void TryFinalizeCorpse();
+
+	void FinalizeCorpse();
+
 	FORCEINLINE void ResetCanTakeDamage() { bCanTakeDamage = true; }
 
 	void AggroAfterHit();
@@ -631,9 +729,11 @@ public:
 
 	EBoneHitReactValue GetLastBoneHitMapping();
 
-	FHitReact GetHitReactToPlay();
+	// picks the hit react for the last hit (bone, direction, incapacitated) + updates the limb hit counters
+	const FMontageSection& GetHitReactToPlay();
 
-	UFUNCTION(BlueprintImplementableEvent)
+	// spawns the archetype's BloodImpactParticles1/2 through the FX pool (BP overrides should call the parent to stay pooled)
+	UFUNCTION(BlueprintNativeEvent)
 	void PlayBloodHitFX(FHitResult Hit);
 
 	UFUNCTION(BlueprintImplementableEvent)
@@ -642,9 +742,11 @@ public:
 
 	FORCEINLINE void ResetEngaged() { SetEnemyCombatState(EEnemyCombatState::ECS_Attacking); }
 
-	void PlayMontageSection(UAnimMontage* Montage, const FName& SectionName);
+	// this enemy's montage sections, resolved once per archetype
+	const FEnemyMontageTable& GetMontageTable();
 
-	int32 PlayRandomMontageSection(UAnimMontage* Montage, const TArray<FName>& SectionNames);
+	// plays a random section from the list; returns its length
+	float PlayRandomMontageSection(const FMontageSectionList& SectionList);
 
 	float PlayAttackMontage();
 
@@ -660,21 +762,26 @@ public:
 
 	void RotateTowardsThenChasePlayer();
 
-	FORCEINLINE bool IsPlayerOutsideCombatRadius() { return !InTargetRange(CombatTarget, CombatRadius); }
+	// range checks against the combat target; read from the state store's range pass when managed
+	bool IsCombatTargetInRange(uint8 RangeFlag, float Range);
 
-	FORCEINLINE bool IsPlayerOutsideAttackRange() { return !InTargetRange(CombatTarget, AttackRange); }
+	bool IsPlayerOutsideCombatRadius();
 
-	FORCEINLINE bool IsPlayerOutsideLungeAttackRange() { return !InTargetRange(CombatTarget, LungeAttackRange); }
+	bool IsPlayerOutsideAttackRange();
 
-	FORCEINLINE bool IsPlayerInsideAttackRange() { return InTargetRange(CombatTarget, AttackRange); }
+	bool IsPlayerOutsideLungeAttackRange();
 
-	FORCEINLINE bool IsPlayerInsideLungeAttackRange() { return InTargetRange(CombatTarget, LungeAttackRange); }
+	bool IsPlayerInsideAttackRange();
 
-	FORCEINLINE bool IsEnemyChasing() { return CombatState == EEnemyCombatState::ECS_Chasing; }
+	bool IsPlayerInsideLungeAttackRange();
 
-	FORCEINLINE bool IsEnemyAttacking() { return CombatState == EEnemyCombatState::ECS_Attacking; }
+	EEnemyHostileDecision GetHostileDecision();
 
-	FORCEINLINE bool IsEnemyEngaged() { return CombatState == EEnemyCombatState::ECS_Engaged; }
+	FORCEINLINE bool IsEnemyChasing() { return GetEnemyCombatState() == EEnemyCombatState::ECS_Chasing; }
+
+	FORCEINLINE bool IsEnemyAttacking() { return GetEnemyCombatState() == EEnemyCombatState::ECS_Attacking; }
+
+	FORCEINLINE bool IsEnemyEngaged() { return GetEnemyCombatState() == EEnemyCombatState::ECS_Engaged; }
 
 	UFUNCTION(BlueprintCallable)
 	bool CanAttack();
@@ -698,11 +805,13 @@ public:
 
 	bool IsClearBehind();
 
-	UFUNCTION(BlueprintImplementableEvent)
+	// spawns the archetype's BloodPool under the body through the FX pool (BP overrides should call the parent to stay pooled)
+	UFUNCTION(BlueprintNativeEvent)
 	void SpawnBloodPoolBP();
 
 	void WanderAway();
 
+	// queues an async LOS check to the combat target (see UEnemyPerceptionSubsystem)
 	void CheckPlayerLOS();
 
 	void LoseTarget();
@@ -710,15 +819,55 @@ public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void StopRespawn();
 
+	/*
+	*  pooling (see UEnemyPoolSubsystem)
+	*/
+
+	// bring a dead or dormant enemy back as a fresh one at the given transform
+	void ResetForReuse(const FTransform& SpawnTransform);
+
+	// hide + disable everything while waiting in the pool
+	void DeactivateForPool();
+
+	// pick new clothing/hair/etc. for a recycled enemy
+	UFUNCTION(BlueprintImplementableEvent)
+	void RandomizeAppearanceBP();
+
+	// rebuild any merged modular meshes after the appearance changed (see UAppearanceBuilderSubsystem)
+	UFUNCTION(BlueprintCallable, Category = "Appearance")
+	virtual void RebuildAppearance() {}
+
+	// register this enemy's current skeletal meshes with UHitZoneSubsystem + compile their hit react tables (again after an appearance change)
+	void BuildHitZones();
+
 	UFUNCTION(BlueprintImplementableEvent)
 	void SetIgnoreBloodChannel();
 
 	UFUNCTION(BlueprintImplementableEvent)
 	void PlayPhysicalHitReact();
 
-	FName GetTorsoHitReactSectionName(ELastHitDirection LastHitDirection);
-
 	UFUNCTION(BlueprintImplementableEvent)
 	void ApplyDeathblowImpulseBP();
 
+private:
+
+	/*
+	*  hot state, moved into the state store slot while this enemy is managed (and back out when it is released), so
+	*  these only hold it while unmanaged. use the getters / setters above
+	*/
+
+	friend struct FEnemyStateStore;
+
+	UPROPERTY(VisibleAnywhere, BlueprintGetter = GetEnemyAwarenessLevel, Category = "AI", meta = (AllowPrivateAccess = "true"))
+	EEnemyAwarenessLevel AwarenessLevel;
+
+	UPROPERTY(VisibleAnywhere, BlueprintGetter = GetEnemyCombatState, Category = "AI", meta = (AllowPrivateAccess = "true"))
+	EEnemyCombatState CombatState;
+
+	UPROPERTY(EditAnywhere, BlueprintGetter = GetAlive, BlueprintSetter = SetAlive, Category = "Stats", meta = (AllowPrivateAccess = "true"))
+	bool bAlive;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintGetter = GetAttackRange, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	float AttackRange;
+
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyArchetype.h"
+#include "../Animation/EnemyMontageTable.h"
+
+
+// sets default values (matching AEnemy's legacy ones)
+UEnemyArchetype::UEnemyArchetype()
+{
+	ZombieType = EZombieType::EMS_MAX;
+
+	MaxHealth = 150.f;
+	Damage = 35.f;
+	PassiveWalkSpeed = 20.f;
+	HostileWalkSpeed = 40.f;
+	PassiveRotationRate = FRotator(0.f, 30.f, 0.f);
+	HostileRotationRate = FRotator(0.f, 90.f, 0.f);
+	IncapacitatedRotationRate = FRotator(0.f, 60.f, 0.f);
+
+	PerceptionRange = 2000.f;
+	VisionRange = 1500.f;
+	VisionAggroRange = VisionRange;
+	HearingAggroRange = PerceptionRange;
+	PeripheralVisionAngle = 75.f;
+	TargetLossDelay = 3.f;
+
+	PatrolAcceptanceRadius = 150.f;
+	PatrolIdleTimeMin = 10.f;
+	PatrolIdleTimeMax = 15.f;
+	PassiveRotateTowardsDelay = 2.f;
+	HostileRotateTowardsDelay = 1.f;
+
+	CombatRadius = 1000.f;
+	AttackRange = 100.f;
+	LungeAttackRange = 150.f;
+	CrawlingAttackRange = 125.f;
+	MoveToAcceptanceRadius = 15.f;
+	CrawlingMoveToAcceptanceRadius = 45.f;
+	AttackDelayMin = 1.f;
+	AttackDelayMax = 2.f;
+	TakeDamageDelay = 0.25f;
+
+	TorsoPhysicalHitReactStrength = 0.f;
+	HeadPhysicalHitReactStrength = 0.f;
+	ArmPhysicalHitReactStrength = 0.f;
+	LegPhysicalHitReactStrength = 0.f;
+
+	HitReactsTorso = nullptr;
+	HitReactsLimbs = nullptr;
+	HitReactsCrawling = nullptr;
+	AttackCloseMontage = nullptr;
+	AttackDistanceMontage = nullptr;
+	CrawlingAttackMontage = nullptr;
+	DeathMontage = nullptr;
+	DeathDirectionalMontage = nullptr;
+	DeathFallBackwardsMontage = nullptr;
+	DeathFallForwardsMontage = nullptr;
+	CrawlingDeathMontage = nullptr;
+
+	BloodImpactParticles1 = nullptr;
+	BloodImpactParticles2 = nullptr;
+	BloodPool = nullptr;
+
+	RandomIdleCue = nullptr;
+	RandomChasingCue = nullptr;
+	RandomHurtCue = nullptr;
+	RandomDeathCue = nullptr;
+	RandomAttackShortCue = nullptr;
+	RandomAttackLongCue = nullptr;
+	IdleCueIntervalMin = 5.f;
+	IdleCueIntervalMax = 12.f;
+	ChasingCueIntervalMin = 4.f;
+	ChasingCueIntervalMax = 6.f;
+}
+
+
+FPrimaryAssetId UEnemyArchetype::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FPrimaryAssetType("EnemyArchetype"), GetFName());
+}
+
+
+#if WITH_EDITOR
+void UEnemyArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// montages/sections may have changed; re-resolve on next use
+	MontageTable.Reset();
+}
+#endif
+
+
+const FEnemyMontageTable& UEnemyArchetype::GetMontageTable() const
+{
+	if (!MontageTable.IsValid())
+	{
+		MontageTable = MakeShared<FEnemyMontageTable>();
+		MontageTable->Build(*this);
+	}
+
+	return *MontageTable;
+}
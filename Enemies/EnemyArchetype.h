@@ -0,0 +1,278 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "../Enemies/Enemy.h"
+#include "EnemyArchetype.generated.h"
+
+class UAnimMontage;
+class UNiagaraSystem;
+class USoundBase;
+class USoundCue;
+struct FEnemyMontageTable;
+
+UENUM(BlueprintType)
+enum class EZombieType : uint8
+{
+	EMS_MaleSkinny		UMETA(DisplayName = "MaleSkinny"),
+	EMS_MaleBloated		UMETA(DisplayName = "MaleBloated"),
+	EMS_FemaleSkinny	UMETA(DisplayName = "FemaleSkinny"),
+	EMS_FemaleBloated	UMETA(DisplayName = "FemaleBloated"),
+
+	EMS_MAX			UMETA(DisplayName = "DefaultMAX")
+};
+
+
+/**
+ *  shared, read-only designer data for one type of enemy (one per zombie type): tuning, montages + their sections,
+ *  bone -> hit react mapping, FX and speech cues. enemies read it directly instead of carrying their own copies (only
+ *  health and the current attack range / acceptance radius live on the enemy)
+ */
+UCLASS(BlueprintType)
+class ESCAPEROOMPROJECT_API UEnemyArchetype : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyArchetype();
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// montage sections below, resolved to indices on first use + shared by every enemy of this type
+	const FEnemyMontageTable& GetMontageTable() const;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Type")
+	EZombieType ZombieType;
+
+	/*
+	*  stats + movement
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float MaxHealth;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float Damage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float PassiveWalkSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	float HostileWalkSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	FRotator PassiveRotationRate;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	FRotator HostileRotationRate;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+	FRotator IncapacitatedRotationRate;
+
+	/*
+	*  perception
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float PeripheralVisionAngle;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float PerceptionRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float VisionRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float VisionAggroRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float HearingAggroRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Perception")
+	float TargetLossDelay;
+
+	/*
+	*  navigation
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI Navigation")
+	float PatrolAcceptanceRadius;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI Navigation")
+	float PatrolIdleTimeMin;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI Navigation")
+	float PatrolIdleTimeMax;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI Navigation")
+	float PassiveRotateTowardsDelay;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI Navigation")
+	float HostileRotateTowardsDelay;
+
+	/*
+	*  combat
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float CombatRadius;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float AttackRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float LungeAttackRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float CrawlingAttackRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float MoveToAcceptanceRadius;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float CrawlingMoveToAcceptanceRadius;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float AttackDelayMin;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float AttackDelayMax;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float TakeDamageDelay;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	TSubclassOf<UDamageType> DamageTypeClass;
+
+	// bone name -> which hit react set to play
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	TMap<FName, EBoneHitReactValue> BoneHitReactMap;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float TorsoPhysicalHitReactStrength;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float HeadPhysicalHitReactStrength;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float ArmPhysicalHitReactStrength;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+	float LegPhysicalHitReactStrength;
+
+	/*
+	*  montages
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* HitReactsTorso;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* HitReactsLimbs;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* HitReactsCrawling;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* AttackCloseMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> AttackCloseMontageSections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* AttackDistanceMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> AttackDistanceMontageSections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* CrawlingAttackMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> CrawlingAttackMontageSections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* DeathMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> DeathMontageAllSections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> DeathMontageBackwardOnlySections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> DeathMontageForwardOnlySections;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* DeathDirectionalMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* DeathFallBackwardsMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* DeathFallForwardsMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	UAnimMontage* CrawlingDeathMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Montages")
+	TArray<FName> CrawlingDeathMontageSections;
+
+	/*
+	*  FX
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	UNiagaraSystem* BloodImpactParticles1;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	UNiagaraSystem* BloodImpactParticles2;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	UNiagaraSystem* BloodPool;
+
+	/*
+	*  speech
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundBase* RandomIdleCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundCue* RandomChasingCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundCue* RandomHurtCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundCue* RandomDeathCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundCue* RandomAttackShortCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	USoundCue* RandomAttackLongCue;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	float IdleCueIntervalMin;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	float IdleCueIntervalMax;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	float ChasingCueIntervalMin;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SFX")
+	float ChasingCueIntervalMax;
+
+protected:
+
+	mutable TSharedPtr<FEnemyMontageTable> MontageTable;
+};
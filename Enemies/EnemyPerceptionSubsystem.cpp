@@ -0,0 +1,358 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyPerceptionSubsystem.h"
+#include "../EscapeRoomProject.h"
+#include "../Enemies/Enemy.h"
+#include "../Enemies/EnemyArchetype.h"
+#include "Components/PawnNoiseEmitterComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Sense Pass"), STAT_EnemySensePass, STATGROUP_EnemyAI);
+DECLARE_CYCLE_STAT(TEXT("Enemy LOS Resolve"), STAT_EnemyLOSResolve, STATGROUP_EnemyAI);
+DECLARE_CYCLE_STAT(TEXT("Enemy LOS Submit"), STAT_EnemyLOSSubmit, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOS Traces Submitted"), STAT_EnemyLOSTraces, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Sensed"), STAT_EnemiesSensed, STATGROUP_EnemyAI);
+
+
+void FEnemyPerceptionData::Add()
+{
+	PositionX.Add(0.f);
+	PositionY.Add(0.f);
+	PositionZ.Add(0.f);
+	ForwardX.Add(0.f);
+	ForwardY.Add(0.f);
+	ForwardZ.Add(0.f);
+	VisionConeCosSquared.Add(0.f);
+	VisionRangeSquared.Add(0.f);
+	HearingRangeSquared.Add(0.f);
+	bInVisionCone.Add(0);
+	bInHearingRange.Add(0);
+	bPlayerSeen.Add(0);
+	bWasHostile.Add(0);
+}
+
+
+void FEnemyPerceptionData::RemoveAtSwap(int32 Index)
+{
+	PositionX.RemoveAtSwap(Index);
+	PositionY.RemoveAtSwap(Index);
+	PositionZ.RemoveAtSwap(Index);
+	ForwardX.RemoveAtSwap(Index);
+	ForwardY.RemoveAtSwap(Index);
+	ForwardZ.RemoveAtSwap(Index);
+	VisionConeCosSquared.RemoveAtSwap(Index);
+	VisionRangeSquared.RemoveAtSwap(Index);
+	HearingRangeSquared.RemoveAtSwap(Index);
+	bInVisionCone.RemoveAtSwap(Index);
+	bInHearingRange.RemoveAtSwap(Index);
+	bPlayerSeen.RemoveAtSwap(Index);
+	bWasHostile.RemoveAtSwap(Index);
+}
+
+
+// sets default values
+UEnemyPerceptionSubsystem::UEnemyPerceptionSubsystem()
+{
+	SenseInterval = 0.25f;
+	MaxTracesPerFrame = 32;
+	LastSenseTime = 0.0;
+}
+
+
+TStatId UEnemyPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+
+void UEnemyPerceptionSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || PerceivingEnemies.Contains(Enemy)) { return; }
+
+	PerceivingEnemies.Add(Enemy);
+	PerceptionData.Add();
+}
+
+
+void UEnemyPerceptionSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	CancelPlayerLOS(Enemy);
+
+	const int32 Index = PerceivingEnemies.Find(Enemy);
+	if (Index == INDEX_NONE) { return; }
+
+	PerceivingEnemies.RemoveAtSwap(Index);
+	PerceptionData.RemoveAtSwap(Index);
+}
+
+
+void UEnemyPerceptionSubsystem::RequestPlayerLOS(AEnemy* Enemy)
+{
+	QueueTrace(Enemy, false);
+}
+
+
+void UEnemyPerceptionSubsystem::CancelPlayerLOS(AEnemy* Enemy)
+{
+	// queued / in-flight entries for this enemy are skipped once it is no longer outstanding
+	OutstandingEnemies.Remove(Enemy);
+}
+
+
+void UEnemyPerceptionSubsystem::QueueTrace(AEnemy* Enemy, bool bSightCheck)
+{
+	if (Enemy == nullptr || OutstandingEnemies.Contains(Enemy)) { return; }
+
+	OutstandingEnemies.Add(Enemy);
+
+	FPendingLOSTrace Request;
+	Request.Enemy = Enemy;
+	Request.bSightCheck = bSightCheck;
+	QueuedRequests.Add(Request);
+}
+
+
+void UEnemyPerceptionSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) { return; }
+
+	// last frame's traces first, so an enemy that is resolved now can re-request this frame
+	ResolveInFlightTraces();
+
+	if (World->GetTimeSeconds() - LastSenseTime >= SenseInterval)
+	{ RunSensePass(); }
+
+	SubmitQueuedRequests();
+}
+
+
+void UEnemyPerceptionSubsystem::RunSensePass()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemySensePass);
+
+	const double PreviousSenseTime = LastSenseTime;
+	LastSenseTime = GetWorld()->GetTimeSeconds();
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (PlayerPawn == nullptr || PerceivingEnemies.Num() == 0) { return; }
+
+	// a dead player can't be perceived
+	const bool bPlayerPerceivable = !PlayerPawn->ActorHasTag(FName("Dead"));
+
+	// did the player make a (self-originated) noise since the last pass?
+	bool bPlayerMadeNoise = false;
+	float NoiseLoudness = 0.f;
+	if (UPawnNoiseEmitterComponent* NoiseEmitter = PlayerPawn->GetPawnNoiseEmitterComponent())
+	{
+		bPlayerMadeNoise = NoiseEmitter->GetLastNoiseTime(true) > PreviousSenseTime;
+		NoiseLoudness = NoiseEmitter->GetLastNoiseVolume(true);
+	}
+
+	GatherPerceptionInputs();
+	EvaluateSenses(PlayerPawn->GetActorLocation(), bPlayerPerceivable && bPlayerMadeNoise, NoiseLoudness);
+
+	if (bPlayerPerceivable)
+	{ DispatchSenseChanges(PlayerPawn, bPlayerMadeNoise); }
+
+	INC_DWORD_STAT_BY(STAT_EnemiesSensed, PerceivingEnemies.Num());
+}
+
+
+// copy the per-enemy inputs out of the actors, once per pass
+void UEnemyPerceptionSubsystem::GatherPerceptionInputs()
+{
+	for (int32 Index = 0; Index < PerceivingEnemies.Num(); ++Index)
+	{
+		const AEnemy* Enemy = PerceivingEnemies[Index];
+		const bool bPerceiving = Enemy != nullptr && Enemy->GetAlive();
+
+		if (!bPerceiving)
+		{
+			PerceptionData.VisionRangeSquared[Index] = -1.f;
+			PerceptionData.HearingRangeSquared[Index] = -1.f;
+			continue;
+		}
+
+		const FVector Location = Enemy->GetActorLocation();
+		const FVector Forward = Enemy->GetActorForwardVector();
+		PerceptionData.PositionX[Index] = Location.X;
+		PerceptionData.PositionY[Index] = Location.Y;
+		PerceptionData.PositionZ[Index] = Location.Z;
+		PerceptionData.ForwardX[Index] = Forward.X;
+		PerceptionData.ForwardY[Index] = Forward.Y;
+		PerceptionData.ForwardZ[Index] = Forward.Z;
+
+		const UEnemyArchetype& Archetype = Enemy->GetArchetype();
+		const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Archetype.PeripheralVisionAngle));
+		PerceptionData.VisionConeCosSquared[Index] = CosHalfAngle * CosHalfAngle;
+
+		// can only aggro within both vision ranges, and nothing is perceived beyond the perception range
+		const float VisionRange = FMath::Min3(Archetype.VisionRange, Archetype.VisionAggroRange, Archetype.PerceptionRange);
+		const float HearingRange = FMath::Min(Archetype.HearingAggroRange, Archetype.PerceptionRange);
+		PerceptionData.VisionRangeSquared[Index] = VisionRange * VisionRange;
+		PerceptionData.HearingRangeSquared[Index] = HearingRange * HearingRange;
+
+		// an enemy that just calmed down should be able to spot the player again straight away
+		const uint8 bHostile = Enemy->GetEnemyAwarenessLevel() == EEnemyAwarenessLevel::EAL_Hostile ? 1 : 0;
+		if (!bHostile && PerceptionData.bWasHostile[Index])
+		{ PerceptionData.bPlayerSeen[Index] = 0; }
+		PerceptionData.bWasHostile[Index] = bHostile;
+	}
+}
+
+
+// branch-free cone + range tests over the flat arrays (vectorizable)
+void UEnemyPerceptionSubsystem::EvaluateSenses(const FVector& PlayerLocation, bool bPlayerMadeNoise, float NoiseLoudness)
+{
+	const int32 NumEnemies = PerceptionData.Num();
+	const float PlayerX = PlayerLocation.X;
+	const float PlayerY = PlayerLocation.Y;
+	const float PlayerZ = PlayerLocation.Z;
+	const float HearingScale = bPlayerMadeNoise ? NoiseLoudness * NoiseLoudness : 0.f;
+
+	const float* RESTRICT PosX = PerceptionData.PositionX.GetData();
+	const float* RESTRICT PosY = PerceptionData.PositionY.GetData();
+	const float* RESTRICT PosZ = PerceptionData.PositionZ.GetData();
+	const float* RESTRICT FwdX = PerceptionData.ForwardX.GetData();
+	const float* RESTRICT FwdY = PerceptionData.ForwardY.GetData();
+	const float* RESTRICT FwdZ = PerceptionData.ForwardZ.GetData();
+	const float* RESTRICT ConeCosSq = PerceptionData.VisionConeCosSquared.GetData();
+	const float* RESTRICT VisionRangeSq = PerceptionData.VisionRangeSquared.GetData();
+	const float* RESTRICT HearingRangeSq = PerceptionData.HearingRangeSquared.GetData();
+	uint8* RESTRICT InCone = PerceptionData.bInVisionCone.GetData();
+	uint8* RESTRICT InHearing = PerceptionData.bInHearingRange.GetData();
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		const float DX = PlayerX - PosX[Index];
+		const float DY = PlayerY - PosY[Index];
+		const float DZ = PlayerZ - PosZ[Index];
+		const float DistSq = DX * DX + DY * DY + DZ * DZ;
+		const float Dot = DX * FwdX[Index] + DY * FwdY[Index] + DZ * FwdZ[Index];
+
+		// in front, and angle to player within the half-angle: Dot / Dist >= Cos  <=>  Dot^2 >= Cos^2 * Dist^2
+		const bool bInRange = DistSq <= VisionRangeSq[Index];
+		const bool bInFront = Dot >= 0.f;
+		const bool bInAngle = Dot * Dot >= ConeCosSq[Index] * DistSq;
+		InCone[Index] = (uint8)(bInRange & bInFront & bInAngle);
+
+		// louder noises carry further (PawnSensing-style: range scaled by loudness)
+		InHearing[Index] = (uint8)(DistSq <= HearingRangeSq[Index] * HearingScale);
+	}
+}
+
+
+void UEnemyPerceptionSubsystem::DispatchSenseChanges(APawn* PlayerPawn, bool bPlayerMadeNoise)
+{
+	for (int32 Index = 0; Index < PerceivingEnemies.Num(); ++Index)
+	{
+		AEnemy* Enemy = PerceivingEnemies[Index];
+		if (Enemy == nullptr || !Enemy->GetAlive()) { continue; }
+
+		// player left the cone; a later re-entry counts as a new sighting
+		if (!PerceptionData.bInVisionCone[Index])
+		{ PerceptionData.bPlayerSeen[Index] = 0; }
+
+		// newly in the cone of a passive enemy: confirm with a LOS trace before reporting it
+		else if (!PerceptionData.bPlayerSeen[Index] && Enemy->GetEnemyAwarenessLevel() == EEnemyAwarenessLevel::EAL_Passive)
+		{ QueueTrace(Enemy, true); }
+
+		// noises are discrete events, so each one heard is a change
+		if (bPlayerMadeNoise && PerceptionData.bInHearingRange[Index])
+		{ Enemy->PawnHeard(PlayerPawn); }
+	}
+}
+
+
+void UEnemyPerceptionSubsystem::ResolveInFlightTraces()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyLOSResolve);
+
+	UWorld* World = GetWorld();
+	if (InFlightTraces.Num() == 0) { return; }
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	for (const FPendingLOSTrace& PendingTrace : InFlightTraces)
+	{
+		AEnemy* Enemy = PendingTrace.Enemy.Get();
+		if (Enemy == nullptr || !OutstandingEnemies.Contains(PendingTrace.Enemy)) { continue; }
+
+		FTraceDatum TraceDatum;
+		if (!World->QueryTraceData(PendingTrace.TraceHandle, TraceDatum))
+		{
+			// result no longer available (e.g., a hitch skipped the frame); ask again
+			QueuedRequests.Add(PendingTrace);
+			continue;
+		}
+
+		OutstandingEnemies.Remove(PendingTrace.Enemy);
+
+		// nothing blocking between enemy and player -> visible
+		const bool bBlocked = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+
+		if (!PendingTrace.bSightCheck)
+		{
+			Enemy->OnPlayerLOSResolved(!bBlocked);
+			continue;
+		}
+
+		// sighting confirmed: record it so it is only dispatched once per cone entry
+		const int32 Index = PerceivingEnemies.Find(Enemy);
+		if (!bBlocked && PlayerPawn != nullptr && Index != INDEX_NONE && PerceptionData.bInVisionCone[Index])
+		{
+			PerceptionData.bPlayerSeen[Index] = 1;
+			Enemy->PawnSeen(PlayerPawn);
+		}
+	}
+
+	InFlightTraces.Reset();
+}
+
+
+void UEnemyPerceptionSubsystem::SubmitQueuedRequests()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyLOSSubmit);
+
+	UWorld* World = GetWorld();
+	if (QueuedRequests.Num() == 0) { return; }
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	int32 NumProcessed = 0;
+	int32 NumSubmitted = 0;
+
+	for (; NumProcessed < QueuedRequests.Num() && NumSubmitted < MaxTracesPerFrame; ++NumProcessed)
+	{
+		FPendingLOSTrace& Request = QueuedRequests[NumProcessed];
+		AEnemy* Enemy = Request.Enemy.Get();
+		if (Enemy == nullptr || !OutstandingEnemies.Contains(Request.Enemy)) { continue; }
+
+		// sight checks look for the player; tracking checks look for the current combat target
+		const AActor* Target = Request.bSightCheck ? PlayerPawn : Enemy->CombatTarget;
+
+		// target went away while queued; no trace needed
+		if (Target == nullptr)
+		{
+			OutstandingEnemies.Remove(Request.Enemy);
+			if (!Request.bSightCheck) { Enemy->OnPlayerLOSResolved(false); }
+			continue;
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(EnemyPlayerLOS));
+		QueryParams.AddIgnoredActor(Enemy);
+		QueryParams.AddIgnoredActor(Target);
+
+		Request.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Enemy->GetActorLocation(), Target->GetActorLocation(), ECollisionChannel::ECC_Visibility, QueryParams);
+		InFlightTraces.Add(Request);
+
+		++NumSubmitted;
+	}
+
+	// keep whatever didn't fit in this frame's cap, in order
+	QueuedRequests.RemoveAt(0, NumProcessed, false);
+
+	INC_DWORD_STAT_BY(STAT_EnemyLOSTraces, NumSubmitted);
+}
@@ -0,0 +1,131 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPerceptionSubsystem.generated.h"
+
+class AEnemy;
+
+// an enemy -> player line-of-sight trace that has been submitted and awaits its result
+USTRUCT()
+struct FPendingLOSTrace
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AEnemy> Enemy;
+
+	FTraceHandle TraceHandle;
+
+	// true: confirming a vision-cone hit (passive enemy); false: hostile enemy tracking its combat target
+	bool bSightCheck = false;
+};
+
+
+// per-enemy perception inputs + results, stored as parallel arrays so the sense pass is a flat loop over floats
+struct FEnemyPerceptionData
+{
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+
+	TArray<float> ForwardX;
+	TArray<float> ForwardY;
+	TArray<float> ForwardZ;
+
+	// squared cosine of the peripheral vision half-angle (sign handled separately)
+	TArray<float> VisionConeCosSquared;
+	TArray<float> VisionRangeSquared;
+	TArray<float> HearingRangeSquared;
+
+	// results of the last pass (0/1)
+	TArray<uint8> bInVisionCone;
+	TArray<uint8> bInHearingRange;
+
+	// state used to only dispatch on changes
+	TArray<uint8> bPlayerSeen;
+	TArray<uint8> bWasHostile;
+
+	void Add();
+	void RemoveAtSwap(int32 Index);
+	int32 Num() const { return PositionX.Num(); }
+};
+
+
+/**
+ *  single perception service for all enemies: each sense pass tests every enemy's vision cone + hearing range
+ *  against the player in one loop, confirms sightings with batched async line traces, and calls back into
+ *  enemies only when what they perceive changes
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UEnemyPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyPerceptionSubsystem();
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// called by enemies on BeginPlay / EndPlay
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	// queue a LOS check from this enemy to its combat target; duplicate requests are ignored while one is outstanding
+	void RequestPlayerLOS(AEnemy* Enemy);
+
+	// drop any outstanding request (e.g., enemy removed from play)
+	void CancelPlayerLOS(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	FORCEINLINE int32 GetNumPerceivingEnemies() const { return PerceivingEnemies.Num(); }
+
+	/*
+	*  tuning
+	*/
+
+	// seconds between sense passes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float SenseInterval;
+
+	// upper bound on async traces submitted per frame; any overflow is carried over to the next frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	int32 MaxTracesPerFrame;
+
+protected:
+
+	// parallel to PerceptionData
+	UPROPERTY(Transient)
+	TArray<AEnemy*> PerceivingEnemies;
+
+	FEnemyPerceptionData PerceptionData;
+
+	double LastSenseTime;
+
+	// requested this frame (or carried over), not yet submitted
+	TArray<FPendingLOSTrace> QueuedRequests;
+
+	// submitted last frame; resolved this frame
+	TArray<FPendingLOSTrace> InFlightTraces;
+
+	// every enemy with a queued or in-flight request, for O(1) de-duplication
+	TSet<TWeakObjectPtr<AEnemy>> OutstandingEnemies;
+
+	void RunSensePass();
+
+	void GatherPerceptionInputs();
+
+	void EvaluateSenses(const FVector& PlayerLocation, bool bPlayerMadeNoise, float NoiseLoudness);
+
+	void DispatchSenseChanges(APawn* PlayerPawn, bool bPlayerMadeNoise);
+
+	void QueueTrace(AEnemy* Enemy, bool bSightCheck);
+
+	void ResolveInFlightTraces();
+
+	void SubmitQueuedRequests();
+};
@@ -0,0 +1,137 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyPoolSubsystem.h"
+#include "../Enemies/Enemy.h"
+#include "EngineUtils.h"
+
+
+// sets default values
+UEnemyPoolSubsystem::UEnemyPoolSubsystem()
+{
+	PrewarmCountPerZone = 2;
+}
+
+
+FEnemyPoolKey UEnemyPoolSubsystem::MakeKey(const AEnemy* Enemy)
+{
+	FEnemyPoolKey Key;
+	Key.Zone = Enemy->AssignedZone;
+	Key.EnemyClass = Enemy->GetClass();
+	return Key;
+}
+
+
+void UEnemyPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// find every zone + enemy type placed in the level
+	TSet<FEnemyPoolKey> ZoneKeys;
+	for (TActorIterator<AEnemy> It(&InWorld); It; ++It)
+	{
+		if (It->AssignedZone != nullptr)
+		{ ZoneKeys.Add(MakeKey(*It)); }
+	}
+
+	// pre-warm each; spawned before actor BeginPlay, so they start out dormant (see AEnemy::BeginPlay)
+	for (const FEnemyPoolKey& Key : ZoneKeys)
+	{
+		FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(Key);
+		Bucket.DormantEnemies.Reserve(PrewarmCountPerZone);
+
+		const FTransform ZoneTransform(Key.Zone->GetActorLocation());
+		for (int32 Count = 0; Count < PrewarmCountPerZone; ++Count)
+		{
+			if (AEnemy* Enemy = SpawnPooledEnemy(Key.EnemyClass, Key.Zone, ZoneTransform))
+			{ Bucket.DormantEnemies.Add(Enemy); }
+		}
+	}
+}
+
+
+AEnemy* UEnemyPoolSubsystem::SpawnPooledEnemy(UClass* EnemyClass, AActor* Zone, const FTransform& SpawnTransform)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || EnemyClass == nullptr) { return nullptr; }
+
+	AEnemy* Enemy = World->SpawnActorDeferred<AEnemy>(EnemyClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Enemy == nullptr) { return nullptr; }
+
+	Enemy->AssignedZone = Zone;
+	Enemy->bInEnemyPool = true;
+	Enemy->FinishSpawning(SpawnTransform);
+
+	// spawned (not placed) pawns don't get an AI controller unless asked for
+	if (Enemy->GetController() == nullptr)
+	{ Enemy->SpawnDefaultController(); }
+
+	return Enemy;
+}
+
+
+AEnemy* UEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, AActor* Zone, const FTransform& SpawnTransform)
+{
+	if (EnemyClass == nullptr) { return nullptr; }
+
+	FEnemyPoolKey Key;
+	Key.Zone = Zone;
+	Key.EnemyClass = EnemyClass;
+	FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(Key);
+
+	AEnemy* Enemy = nullptr;
+
+	if (Bucket.DormantEnemies.Num() > 0)
+	{ Enemy = Bucket.DormantEnemies.Pop(false); }
+
+	// recycle the oldest corpse of this zone
+	else if (Bucket.DeadEnemies.Num() > 0)
+	{
+		Enemy = Bucket.DeadEnemies[0];
+		Bucket.DeadEnemies.RemoveAt(0, 1, false);
+	}
+
+	// pool exhausted; spawn one more (pre-warm count for this zone is too low)
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Enemy pool miss for %s in zone %s; spawning a new enemy"), *EnemyClass->GetName(), *GetNameSafe(Zone));
+		Enemy = SpawnPooledEnemy(EnemyClass, Zone, SpawnTransform);
+	}
+
+	if (Enemy != nullptr)
+	{ Enemy->ResetForReuse(SpawnTransform); }
+
+	return Enemy;
+}
+
+
+void UEnemyPoolSubsystem::ReleaseEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) { return; }
+
+	FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(MakeKey(Enemy));
+	Bucket.DeadEnemies.RemoveSingle(Enemy);
+
+	Enemy->DeactivateForPool();
+	Bucket.DormantEnemies.AddUnique(Enemy);
+}
+
+
+void UEnemyPoolSubsystem::NotifyEnemyDied(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemy->AssignedZone == nullptr) { return; }
+
+	Buckets.FindOrAdd(MakeKey(Enemy)).DeadEnemies.AddUnique(Enemy);
+}
+
+
+void UEnemyPoolSubsystem::RemoveEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) { return; }
+
+	if (FEnemyPoolBucket* Bucket = Buckets.Find(MakeKey(Enemy)))
+	{
+		Bucket->DormantEnemies.RemoveSingle(Enemy);
+		Bucket->DeadEnemies.RemoveSingle(Enemy);
+	}
+}
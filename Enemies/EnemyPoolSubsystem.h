@@ -0,0 +1,86 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AEnemy;
+
+// enemies are pooled per spawn zone + enemy class
+USTRUCT()
+struct FEnemyPoolKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AActor* Zone = nullptr;
+
+	UPROPERTY()
+	UClass* EnemyClass = nullptr;
+
+	bool operator==(const FEnemyPoolKey& Other) const { return Zone == Other.Zone && EnemyClass == Other.EnemyClass; }
+
+	friend uint32 GetTypeHash(const FEnemyPoolKey& Key) { return HashCombine(GetTypeHash(Key.Zone), GetTypeHash(Key.EnemyClass)); }
+};
+
+
+USTRUCT()
+struct FEnemyPoolBucket
+{
+	GENERATED_BODY()
+
+	// hidden, inactive, ready to be handed out
+	UPROPERTY()
+	TArray<AEnemy*> DormantEnemies;
+
+	// corpses still in the world, oldest first; recycled when no dormant enemy is left
+	UPROPERTY()
+	TArray<AEnemy*> DeadEnemies;
+};
+
+
+/**
+ *  keeps a pre-warmed set of enemies per zone so zone respawns reuse existing actors (mesh components,
+ *  controller, behavior tree) instead of spawning new ones mid-fight
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyPoolSubsystem();
+
+	// pre-warms every (zone, enemy class) pair found among the enemies placed in the level
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// hand out an enemy for this zone at the given transform: dormant first, then the oldest corpse, then (pool miss) a new spawn
+	UFUNCTION(BlueprintCallable, Category = "Spawning")
+	AEnemy* AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, AActor* Zone, const FTransform& SpawnTransform);
+
+	// deactivate an enemy + return it to its zone's pool
+	UFUNCTION(BlueprintCallable, Category = "Spawning")
+	void ReleaseEnemy(AEnemy* Enemy);
+
+	// called by enemies from Die(); the corpse becomes a recycling candidate
+	void NotifyEnemyDied(AEnemy* Enemy);
+
+	// called by enemies from EndPlay; forget about it entirely
+	void RemoveEnemy(AEnemy* Enemy);
+
+	// how many extra enemies to pre-warm per (zone, enemy class)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawning")
+	int32 PrewarmCountPerZone;
+
+protected:
+
+	UPROPERTY(Transient)
+	TMap<FEnemyPoolKey, FEnemyPoolBucket> Buckets;
+
+	static FEnemyPoolKey MakeKey(const AEnemy* Enemy);
+
+	AEnemy* SpawnPooledEnemy(UClass* EnemyClass, AActor* Zone, const FTransform& SpawnTransform);
+};
@@ -0,0 +1,150 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyStateStore.h"
+#include "../Enemies/EnemyArchetype.h"
+
+
+int32 FEnemyStateStore::Add(const AEnemy& Enemy)
+{
+	LocationX.Add(0.f);
+	LocationY.Add(0.f);
+	LocationZ.Add(0.f);
+	TargetX.Add(0.f);
+	TargetY.Add(0.f);
+	TargetZ.Add(0.f);
+	bHasTarget.Add(0);
+	bTargetDead.Add(0);
+	AttackRange.Add(Enemy.AttackRange);
+	LungeAttackRange.Add(Enemy.GetArchetype().LungeAttackRange);
+	CombatRadius.Add(Enemy.GetArchetype().CombatRadius);
+	CombatState.Add(Enemy.CombatState);
+	AwarenessLevel.Add(Enemy.AwarenessLevel);
+	bAlive.Add(Enemy.bAlive);
+	DistanceToTarget.Add(0.f);
+	RangeFlags.Add(EEnemyRangeFlags::ERF_None);
+	const int32 Index = HostileDecision.Add(EEnemyHostileDecision::EHD_None);
+
+	GatherInputs(Index, Enemy);
+	return Index;
+}
+
+
+void FEnemyStateStore::RemoveAtSwap(int32 Index, AEnemy& Enemy)
+{
+	Enemy.AttackRange = AttackRange[Index];
+	Enemy.CombatState = CombatState[Index];
+	Enemy.AwarenessLevel = AwarenessLevel[Index];
+	Enemy.bAlive = bAlive[Index] != 0;
+
+	LocationX.RemoveAtSwap(Index);
+	LocationY.RemoveAtSwap(Index);
+	LocationZ.RemoveAtSwap(Index);
+	TargetX.RemoveAtSwap(Index);
+	TargetY.RemoveAtSwap(Index);
+	TargetZ.RemoveAtSwap(Index);
+	bHasTarget.RemoveAtSwap(Index);
+	bTargetDead.RemoveAtSwap(Index);
+	AttackRange.RemoveAtSwap(Index);
+	LungeAttackRange.RemoveAtSwap(Index);
+	CombatRadius.RemoveAtSwap(Index);
+	CombatState.RemoveAtSwap(Index);
+	AwarenessLevel.RemoveAtSwap(Index);
+	bAlive.RemoveAtSwap(Index);
+	DistanceToTarget.RemoveAtSwap(Index);
+	RangeFlags.RemoveAtSwap(Index);
+	HostileDecision.RemoveAtSwap(Index);
+}
+
+
+void FEnemyStateStore::Reset()
+{
+	LocationX.Reset();
+	LocationY.Reset();
+	LocationZ.Reset();
+	TargetX.Reset();
+	TargetY.Reset();
+	TargetZ.Reset();
+	bHasTarget.Reset();
+	bTargetDead.Reset();
+	AttackRange.Reset();
+	LungeAttackRange.Reset();
+	CombatRadius.Reset();
+	CombatState.Reset();
+	AwarenessLevel.Reset();
+	bAlive.Reset();
+	DistanceToTarget.Reset();
+	RangeFlags.Reset();
+	HostileDecision.Reset();
+}
+
+
+void FEnemyStateStore::GatherInputs(int32 Index, const AEnemy& Enemy)
+{
+	const FVector Location = Enemy.GetActorLocation();
+	LocationX[Index] = Location.X;
+	LocationY[Index] = Location.Y;
+	LocationZ[Index] = Location.Z;
+
+	const AActor* Target = Enemy.CombatTarget;
+	bHasTarget[Index] = Target != nullptr;
+	if (Target == nullptr) { return; }
+
+	const FVector TargetLocation = Target->GetActorLocation();
+	TargetX[Index] = TargetLocation.X;
+	TargetY[Index] = TargetLocation.Y;
+	TargetZ[Index] = TargetLocation.Z;
+	bTargetDead[Index] = Target->ActorHasTag(FName("Dead"));
+}
+
+
+void FEnemyStateStore::RunRangePass()
+{
+	const int32 NumEnemies = Num();
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		const float DX = TargetX[Index] - LocationX[Index];
+		const float DY = TargetY[Index] - LocationY[Index];
+		const float DZ = TargetZ[Index] - LocationZ[Index];
+		const float Distance = FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+		DistanceToTarget[Index] = Distance;
+
+		// no target -> out of every range (matches AEnemy::InTargetRange)
+		const uint8 HasTargetMask = bHasTarget[Index] ? 0xFF : 0x00;
+		const uint8 Flags =
+			(Distance <= AttackRange[Index] ? EEnemyRangeFlags::ERF_InAttackRange : 0) |
+			(Distance <= LungeAttackRange[Index] ? EEnemyRangeFlags::ERF_InLungeAttackRange : 0) |
+			(Distance <= CombatRadius[Index] ? EEnemyRangeFlags::ERF_InCombatRadius : 0);
+
+		RangeFlags[Index] = Flags & HasTargetMask;
+	}
+}
+
+
+void FEnemyStateStore::RunDecisionPass()
+{
+	const int32 NumEnemies = Num();
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		EEnemyHostileDecision Decision = EEnemyHostileDecision::EHD_None;
+
+		if (bAlive[Index] && bHasTarget[Index] && AwarenessLevel[Index] == EEnemyAwarenessLevel::EAL_Hostile)
+		{
+			const uint8 Flags = RangeFlags[Index];
+			const bool bChasing = CombatState[Index] == EEnemyCombatState::ECS_Chasing;
+
+			if (bTargetDead[Index] || !(Flags & EEnemyRangeFlags::ERF_InCombatRadius))
+			{ Decision = EEnemyHostileDecision::EHD_LoseInterest; }
+
+			else if (!(Flags & (EEnemyRangeFlags::ERF_InAttackRange | EEnemyRangeFlags::ERF_InLungeAttackRange)) && !bChasing)
+			{ Decision = EEnemyHostileDecision::EHD_Chase; }
+
+			else
+			{ Decision = EEnemyHostileDecision::EHD_Evaluate; }
+		}
+
+		HostileDecision[Index] = Decision;
+	}
+}
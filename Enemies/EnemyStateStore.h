@@ -0,0 +1,85 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Enemies/Enemy.h"
+
+// results of the range pass, packed per enemy
+namespace EEnemyRangeFlags
+{
+	enum Type : uint8
+	{
+		ERF_None				= 0,
+		ERF_InAttackRange		= 1 << 0,
+		ERF_InLungeAttackRange	= 1 << 1,
+		ERF_InCombatRadius		= 1 << 2,
+	};
+}
+
+/**
+ *  hot per-enemy state as parallel arrays, indexed by AEnemy::StateIndex and owned by the UEnemyTickManager.
+ *  holds only what the range + decision passes read. while an enemy is managed its slot is the source of truth for
+ *  its decision state and attack range (AEnemy's getters / setters read + write it); the passes run once per frame
+ */
+struct FEnemyStateStore
+{
+	/*
+	*  gathered from the actors each frame
+	*/
+
+	TArray<float> LocationX;
+	TArray<float> LocationY;
+	TArray<float> LocationZ;
+
+	TArray<float> TargetX;
+	TArray<float> TargetY;
+	TArray<float> TargetZ;
+
+	TArray<uint8> bHasTarget;
+	TArray<uint8> bTargetDead;
+
+	/*
+	*  combat ranges (attack range set through AEnemy::SetAttackRange; the others are the archetype's)
+	*/
+
+	TArray<float> AttackRange;
+	TArray<float> LungeAttackRange;
+	TArray<float> CombatRadius;
+
+	/*
+	*  decision state (set through the AEnemy setters)
+	*/
+
+	TArray<EEnemyCombatState> CombatState;
+	TArray<EEnemyAwarenessLevel> AwarenessLevel;
+	TArray<uint8> bAlive;
+
+	/*
+	*  pass outputs
+	*/
+
+	TArray<float> DistanceToTarget;
+	TArray<uint8> RangeFlags;
+	TArray<EEnemyHostileDecision> HostileDecision;
+
+	// a new slot, taking over the enemy's hot state (its own fields only hold it while unmanaged)
+	int32 Add(const AEnemy& Enemy);
+
+	// drop a slot, handing its hot state back to the enemy
+	void RemoveAtSwap(int32 Index, AEnemy& Enemy);
+
+	void Reset();
+	FORCEINLINE int32 Num() const { return LocationX.Num(); }
+
+	FORCEINLINE bool HasRangeFlag(int32 Index, EEnemyRangeFlags::Type Flag) const { return (RangeFlags[Index] & Flag) != 0; }
+
+	// copy one enemy's location + combat target into its slot
+	void GatherInputs(int32 Index, const AEnemy& Enemy);
+
+	// distances to target + range flags for every enemy
+	void RunRangePass();
+
+	// hostile next-step decision for every enemy, from state + range flags only
+	void RunDecisionPass();
+};
@@ -0,0 +1,236 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyTickManager.h"
+#include "../EscapeRoomProject.h"
+#include "../Enemies/Enemy.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Tick Manager"), STAT_EnemyTickManager, STATGROUP_EnemyAI);
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance"), STAT_EnemySignificance, STATGROUP_EnemyAI);
+DECLARE_CYCLE_STAT(TEXT("Enemy State Passes"), STAT_EnemyStatePasses, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Updated"), STAT_EnemiesUpdated, STATGROUP_EnemyAI);
+
+
+// sets default values
+UEnemyTickManager::UEnemyTickManager()
+{
+	FrameBudgetMs = 1.f;
+	SignificanceUpdateInterval = 0.25f;
+	HighSignificanceDistance = 1500.f;
+	MediumSignificanceDistance = 3000.f;
+	HighUpdateInterval = 0.1f;
+	MediumUpdateInterval = 0.25f;
+	LowUpdateInterval = 1.f;
+
+	UpdateCursor = 0;
+	LastSignificanceUpdateTime = 0.0;
+}
+
+
+TStatId UEnemyTickManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyTickManager, STATGROUP_Tickables);
+}
+
+
+void UEnemyTickManager::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) { return; }
+
+	// not yet managed: add a slot in every parallel array + bind the enemy to it (its hot state moves into the slot)
+	if (Enemy->StateStore != &StateStore)
+	{
+		ManagedEnemies.Add(Enemy);
+		Significances.Add(EEnemySignificance::ES_Low);
+		LastUpdateTimes.Add(GetWorld()->GetTimeSeconds());
+
+		Enemy->StateIndex = StateStore.Add(*Enemy);
+		Enemy->StateStore = &StateStore;
+	}
+
+	RefreshSignificance(Enemy);
+}
+
+
+void UEnemyTickManager::UnregisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemy->StateStore != &StateStore) { return; }
+
+	const int32 Index = Enemy->StateIndex;
+
+	ManagedEnemies.RemoveAtSwap(Index);
+	Significances.RemoveAtSwap(Index);
+	LastUpdateTimes.RemoveAtSwap(Index);
+	StateStore.RemoveAtSwap(Index, *Enemy);
+
+	// the last enemy was swapped into the freed slot
+	if (ManagedEnemies.IsValidIndex(Index) && ManagedEnemies[Index] != nullptr)
+	{ ManagedEnemies[Index]->StateIndex = Index; }
+
+	Enemy->StateStore = nullptr;
+	Enemy->StateIndex = INDEX_NONE;
+
+	if (UpdateCursor >= ManagedEnemies.Num()) { UpdateCursor = 0; }
+}
+
+
+void UEnemyTickManager::RefreshSignificance(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemy->StateStore != &StateStore) { return; }
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+	Significances[Enemy->StateIndex] = ComputeSignificance(Enemy->StateIndex, PlayerLocation, PlayerPawn != nullptr);
+}
+
+
+EEnemySignificance UEnemyTickManager::GetSignificance(const AEnemy* Enemy) const
+{
+	if (Enemy == nullptr || Enemy->StateStore != &StateStore) { return EEnemySignificance::ES_MAX; }
+
+	return Significances[Enemy->StateIndex];
+}
+
+
+void UEnemyTickManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyTickManager);
+
+	UWorld* World = GetWorld();
+	if (World == nullptr) { return; }
+
+	const double CurrentTime = World->GetTimeSeconds();
+
+	// fire expired AI timers (batched) before this frame's updates
+	TimerWheel.Advance(CurrentTime);
+
+	if (ManagedEnemies.Num() == 0) { return; }
+
+	// refresh the hot state every frame; cheap, linear, and keeps range checks current for all buckets
+	{
+		SCOPE_CYCLE_COUNTER(STAT_EnemyStatePasses);
+		GatherStateInputs();
+		StateStore.RunRangePass();
+		StateStore.RunDecisionPass();
+	}
+
+	// periodically re-bucket every enemy
+	if (CurrentTime - LastSignificanceUpdateTime >= SignificanceUpdateInterval)
+	{ UpdateAllSignificances(); }
+
+	// critical enemies (hostile / in combat) update every frame, regardless of budget
+	for (int32 Index = 0; Index < ManagedEnemies.Num(); ++Index)
+	{
+		if (Significances[Index] == EEnemySignificance::ES_Critical)
+		{ UpdateEnemyAt(Index, CurrentTime); }
+	}
+
+	// everything else: round-robin over enemies that are due, until this frame's budget is spent
+	const double BudgetEndTime = FPlatformTime::Seconds() + (FrameBudgetMs / 1000.0);
+	const int32 NumEnemies = ManagedEnemies.Num();
+
+	for (int32 Step = 0; Step < NumEnemies; ++Step)
+	{
+		const int32 Index = (UpdateCursor + Step) % NumEnemies;
+		const EEnemySignificance Significance = Significances[Index];
+
+		if (Significance == EEnemySignificance::ES_Critical || Significance == EEnemySignificance::ES_Dormant) { continue; }
+		if (CurrentTime - LastUpdateTimes[Index] < GetUpdateInterval(Significance)) { continue; }
+
+		// out of time; resume from this enemy next frame
+		if (FPlatformTime::Seconds() > BudgetEndTime)
+		{
+			UpdateCursor = Index;
+			return;
+		}
+
+		UpdateEnemyAt(Index, CurrentTime);
+	}
+
+	UpdateCursor = NumEnemies > 0 ? (UpdateCursor + 1) % NumEnemies : 0;
+}
+
+
+void UEnemyTickManager::UpdateAllSignificances()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemySignificance);
+
+	LastSignificanceUpdateTime = GetWorld()->GetTimeSeconds();
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+	for (int32 Index = 0; Index < ManagedEnemies.Num(); ++Index)
+	{ Significances[Index] = ComputeSignificance(Index, PlayerLocation, PlayerPawn != nullptr); }
+}
+
+
+void UEnemyTickManager::GatherStateInputs()
+{
+	for (int32 Index = 0; Index < ManagedEnemies.Num(); ++Index)
+	{
+		if (const AEnemy* Enemy = ManagedEnemies[Index])
+		{ StateStore.GatherInputs(Index, *Enemy); }
+	}
+}
+
+
+// sort an enemy into a bucket by combat state, distance to player and visibility
+EEnemySignificance UEnemyTickManager::ComputeSignificance(int32 Index, const FVector& PlayerLocation, bool bHavePlayer) const
+{
+	const AEnemy* Enemy = ManagedEnemies[Index];
+	const EEnemyCombatState CombatState = StateStore.CombatState[Index];
+
+	if (Enemy == nullptr || !StateStore.bAlive[Index] || CombatState == EEnemyCombatState::ECS_Dead)
+	{ return EEnemySignificance::ES_Dormant; }
+
+	if (StateStore.AwarenessLevel[Index] == EEnemyAwarenessLevel::EAL_Hostile || CombatState >= EEnemyCombatState::ECS_Chasing)
+	{ return EEnemySignificance::ES_Critical; }
+
+	if (!bHavePlayer) { return EEnemySignificance::ES_Low; }
+
+	const FVector Location(StateStore.LocationX[Index], StateStore.LocationY[Index], StateStore.LocationZ[Index]);
+	const float DistanceSquared = FVector::DistSquared(Location, PlayerLocation);
+
+	if (DistanceSquared <= FMath::Square(HighSignificanceDistance))
+	{ return EEnemySignificance::ES_High; }
+
+	if (DistanceSquared <= FMath::Square(MediumSignificanceDistance) || Enemy->WasRecentlyRendered(0.2f))
+	{ return EEnemySignificance::ES_Medium; }
+
+	return EEnemySignificance::ES_Low;
+}
+
+
+float UEnemyTickManager::GetUpdateInterval(EEnemySignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EEnemySignificance::ES_Critical:
+		return 0.f;
+	case EEnemySignificance::ES_High:
+		return HighUpdateInterval;
+	case EEnemySignificance::ES_Medium:
+		return MediumUpdateInterval;
+	case EEnemySignificance::ES_Low:
+		return LowUpdateInterval;
+
+	default:
+		return MAX_flt;
+	}
+}
+
+
+void UEnemyTickManager::UpdateEnemyAt(int32 Index, double CurrentTime)
+{
+	AEnemy* Enemy = ManagedEnemies[Index];
+	if (Enemy == nullptr) { return; }
+
+	// pass the time elapsed since this enemy's last update, not the frame delta
+	const float EnemyDeltaTime = static_cast<float>(CurrentTime - LastUpdateTimes[Index]);
+	LastUpdateTimes[Index] = CurrentTime;
+
+	Enemy->UpdateEnemyAI(EnemyDeltaTime);
+	INC_DWORD_STAT(STAT_EnemiesUpdated);
+}
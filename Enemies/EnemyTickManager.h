@@ -0,0 +1,122 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Enemies/EnemyStateStore.h"
+#include "../Enemies/EnemyTimerWheel.h"
+#include "EnemyTickManager.generated.h"
+
+class AEnemy;
+
+// how relevant an enemy currently is to the player; determines how often its AI is updated
+UENUM(BlueprintType)
+enum class EEnemySignificance : uint8
+{
+	ES_Critical		UMETA(DisplayName = "Critical"),	// hostile / in combat: updated every frame
+	ES_High			UMETA(DisplayName = "High"),		// close to the player
+	ES_Medium		UMETA(DisplayName = "Medium"),		// on screen, or within mid range
+	ES_Low			UMETA(DisplayName = "Low"),			// far away and not visible
+	ES_Dormant		UMETA(DisplayName = "Dormant"),		// dead; never updated
+
+	ES_MAX			UMETA(DisplayName = "DefaultMAX")
+};
+
+
+/**
+ *  owns the AI updates of every enemy in the world. enemies are sorted into significance buckets
+ *  (distance, visibility, combat state), and each bucket is updated at its own rate under a per-frame time budget.
+ *  also owns the enemies' hot state (FEnemyStateStore), refreshed by linear range + decision passes every frame
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UEnemyTickManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyTickManager();
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// called by enemies on BeginPlay / EndPlay
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	// re-evaluate a single enemy's bucket immediately (e.g., on aggro, so it doesn't wait for the next significance pass)
+	void RefreshSignificance(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	EEnemySignificance GetSignificance(const AEnemy* Enemy) const;
+
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	FORCEINLINE int32 GetNumManagedEnemies() const { return ManagedEnemies.Num(); }
+
+	FORCEINLINE FEnemyStateStore& GetStateStore() { return StateStore; }
+
+	FORCEINLINE FEnemyTimerWheel& GetTimerWheel() { return TimerWheel; }
+
+	/*
+	*  tuning
+	*/
+
+	// time allowed per frame for non-critical enemy updates, in milliseconds (critical enemies always update)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float FrameBudgetMs;
+
+	// how often every enemy's bucket is re-evaluated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float SignificanceUpdateInterval;
+
+	// within this distance of the player, an enemy is highly significant
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float HighSignificanceDistance;
+
+	// within this distance of the player (or on screen), an enemy is of medium significance
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float MediumSignificanceDistance;
+
+	// seconds between updates, per bucket
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float HighUpdateInterval;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float MediumUpdateInterval;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+	float LowUpdateInterval;
+
+protected:
+
+	// parallel arrays, one entry per managed enemy (swap-removed together; index == AEnemy::StateIndex)
+	UPROPERTY(Transient)
+	TArray<AEnemy*> ManagedEnemies;
+
+	FEnemyStateStore StateStore;
+
+	// every enemy's AI timers; advanced at the start of each tick
+	FEnemyTimerWheel TimerWheel;
+
+	TArray<EEnemySignificance> Significances;
+
+	TArray<double> LastUpdateTimes;
+
+	// where the budgeted round-robin pass resumes next frame
+	int32 UpdateCursor;
+
+	double LastSignificanceUpdateTime;
+
+	void UpdateAllSignificances();
+
+	// copy per-frame inputs (locations, combat target) out of the actors into the state store
+	void GatherStateInputs();
+
+	EEnemySignificance ComputeSignificance(int32 Index, const FVector& PlayerLocation, bool bHavePlayer) const;
+
+	float GetUpdateInterval(EEnemySignificance Significance) const;
+
+	void UpdateEnemyAt(int32 Index, double CurrentTime);
+};
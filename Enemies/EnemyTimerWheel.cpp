@@ -0,0 +1,184 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/EnemyTimerWheel.h"
+#include "../EscapeRoomProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Timer Wheel"), STAT_EnemyTimerWheel, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Timers Fired"), STAT_EnemyTimersFired, STATGROUP_EnemyAI);
+
+
+FEnemyTimerWheel::FEnemyTimerWheel()
+{
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{ BucketHeads[Bucket] = INDEX_NONE; }
+
+	CurrentTick = 0;
+	NumActiveTimers = 0;
+}
+
+
+int32 FEnemyTimerWheel::AllocateBlock(AEnemy* Owner)
+{
+	int32 Block;
+
+	if (FreeBlocks.Num() > 0)
+	{
+		Block = FreeBlocks.Pop(false);
+		BlockOwners[Block] = Owner;
+	}
+
+	else
+	{
+		Block = BlockOwners.Add(Owner);
+		Slots.AddDefaulted((int32)EEnemyTimer::ET_MAX);
+	}
+
+	return Block;
+}
+
+
+void FEnemyTimerWheel::FreeBlock(int32 Block)
+{
+	if (!BlockOwners.IsValidIndex(Block)) { return; }
+
+	CancelAll(Block);
+	BlockOwners[Block] = nullptr;
+	FreeBlocks.Add(Block);
+}
+
+
+void FEnemyTimerWheel::Schedule(int32 Block, EEnemyTimer Timer, FEnemyTimerCallback Callback, float Delay)
+{
+	const int32 SlotIdx = SlotIndex(Block, Timer);
+	if (!Slots.IsValidIndex(SlotIdx)) { return; }
+
+	CancelSlot(SlotIdx);
+	if (Delay <= 0.f || Callback == nullptr) { return; }
+
+	// always at least one tick out, so a timer never fires during the call that set it
+	const int64 TicksFromNow = FMath::Max<int64>(1, FMath::CeilToInt64(Delay / Resolution));
+
+	FTimerSlot& Slot = Slots[SlotIdx];
+	Slot.Callback = Callback;
+	Slot.Rounds = (uint32)((TicksFromNow - 1) / NumBuckets);
+	Link(SlotIdx, (int32)((CurrentTick + TicksFromNow) & BucketMask));
+
+	++NumActiveTimers;
+}
+
+
+void FEnemyTimerWheel::Cancel(int32 Block, EEnemyTimer Timer)
+{
+	const int32 SlotIdx = SlotIndex(Block, Timer);
+	if (Slots.IsValidIndex(SlotIdx)) { CancelSlot(SlotIdx); }
+}
+
+
+void FEnemyTimerWheel::CancelAll(int32 Block)
+{
+	for (int32 Timer = 0; Timer < (int32)EEnemyTimer::ET_MAX; ++Timer)
+	{ Cancel(Block, (EEnemyTimer)Timer); }
+}
+
+
+bool FEnemyTimerWheel::IsActive(int32 Block, EEnemyTimer Timer) const
+{
+	const int32 SlotIdx = SlotIndex(Block, Timer);
+	return Slots.IsValidIndex(SlotIdx) && Slots[SlotIdx].Bucket != Inactive;
+}
+
+
+void FEnemyTimerWheel::Advance(double CurrentTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyTimerWheel);
+
+	// tick 0 == world time 0, same clock the wheel was created on
+	const int64 TargetTick = (int64)(CurrentTime / Resolution);
+
+	ExpiredSlots.Reset();
+
+	// walk each elapsed bucket; anything on its last round expires, the rest go around again
+	while (CurrentTick < TargetTick)
+	{
+		++CurrentTick;
+		int32 SlotIdx = BucketHeads[CurrentTick & BucketMask];
+
+		while (SlotIdx != INDEX_NONE)
+		{
+			FTimerSlot& Slot = Slots[SlotIdx];
+			const int32 NextIdx = Slot.Next;
+
+			if (Slot.Rounds == 0)
+			{
+				Unlink(SlotIdx);
+				Slot.Bucket = PendingFire;
+				ExpiredSlots.Add(SlotIdx);
+			}
+
+			else
+			{ --Slot.Rounds; }
+
+			SlotIdx = NextIdx;
+		}
+	}
+
+	// fire the batch; a callback may cancel or re-schedule a later one, so re-check each slot before firing
+	for (const int32 SlotIdx : ExpiredSlots)
+	{
+		FTimerSlot& Slot = Slots[SlotIdx];
+		if (Slot.Bucket != PendingFire) { continue; }
+
+		Slot.Bucket = Inactive;
+		--NumActiveTimers;
+
+		AEnemy* Owner = BlockOwners[SlotIdx / (int32)EEnemyTimer::ET_MAX];
+		const FEnemyTimerCallback Callback = Slot.Callback;
+		Slot.Callback = nullptr;
+
+		if (Owner != nullptr && Callback != nullptr)
+		{ (Owner->*Callback)(); }
+	}
+
+	INC_DWORD_STAT_BY(STAT_EnemyTimersFired, ExpiredSlots.Num());
+}
+
+
+void FEnemyTimerWheel::Link(int32 SlotIdx, int32 Bucket)
+{
+	FTimerSlot& Slot = Slots[SlotIdx];
+	Slot.Bucket = Bucket;
+	Slot.Prev = INDEX_NONE;
+	Slot.Next = BucketHeads[Bucket];
+
+	if (Slot.Next != INDEX_NONE) { Slots[Slot.Next].Prev = SlotIdx; }
+	BucketHeads[Bucket] = SlotIdx;
+}
+
+
+void FEnemyTimerWheel::Unlink(int32 SlotIdx)
+{
+	FTimerSlot& Slot = Slots[SlotIdx];
+
+	if (Slot.Prev != INDEX_NONE) { Slots[Slot.Prev].Next = Slot.Next; }
+	else { BucketHeads[Slot.Bucket] = Slot.Next; }
+
+	if (Slot.Next != INDEX_NONE) { Slots[Slot.Next].Prev = Slot.Prev; }
+
+	Slot.Prev = INDEX_NONE;
+	Slot.Next = INDEX_NONE;
+}
+
+
+void FEnemyTimerWheel::CancelSlot(int32 SlotIdx)
+{
+	FTimerSlot& Slot = Slots[SlotIdx];
+	if (Slot.Bucket == Inactive) { return; }
+
+	// expired-but-not-yet-fired slots are already out of their bucket list
+	if (Slot.Bucket != PendingFire) { Unlink(SlotIdx); }
+
+	Slot.Bucket = Inactive;
+	Slot.Callback = nullptr;
+	--NumActiveTimers;
+}
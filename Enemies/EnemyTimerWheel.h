@@ -0,0 +1,89 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Enemies/Enemy.h"
+
+// member function called when an enemy timer expires
+typedef void (AEnemy::*FEnemyTimerCallback)();
+
+
+/**
+ *  hashed timer wheel for enemy AI timers, owned + advanced by the UEnemyTickManager.
+ *  each enemy gets a fixed block of EEnemyTimer::ET_MAX slots; slots are linked into wheel buckets
+ *  through intrusive index lists, so scheduling and cancelling are O(1) and nothing is allocated per timer.
+ *  expired timers are collected per advance and their callbacks dispatched as one batch
+ */
+class ESCAPEROOMPROJECT_API FEnemyTimerWheel
+{
+public:
+
+	FEnemyTimerWheel();
+
+	// reserve a block of timer slots for an enemy; returns the block index
+	int32 AllocateBlock(AEnemy* Owner);
+
+	// cancel every timer in the block + return it for reuse
+	void FreeBlock(int32 Block);
+
+	// (re)start a timer; a delay <= 0 cancels it (same as FTimerManager::SetTimer)
+	void Schedule(int32 Block, EEnemyTimer Timer, FEnemyTimerCallback Callback, float Delay);
+
+	void Cancel(int32 Block, EEnemyTimer Timer);
+
+	void CancelAll(int32 Block);
+
+	bool IsActive(int32 Block, EEnemyTimer Timer) const;
+
+	// step the wheel up to the given world time + fire everything that expired
+	void Advance(double CurrentTime);
+
+	int32 GetNumActiveTimers() const { return NumActiveTimers; }
+
+private:
+
+	// wheel layout: NumBuckets buckets of Resolution seconds each; longer delays wrap around using Rounds
+	static constexpr int32 NumBuckets = 512;
+	static constexpr int32 BucketMask = NumBuckets - 1;
+	static constexpr double Resolution = 1.0 / 60.0;
+
+	// special Bucket values
+	static constexpr int32 Inactive = INDEX_NONE;
+	static constexpr int32 PendingFire = -2;
+
+	struct FTimerSlot
+	{
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int32 Bucket = Inactive;
+		uint32 Rounds = 0;
+		FEnemyTimerCallback Callback = nullptr;
+	};
+
+	// block * ET_MAX + timer
+	TArray<FTimerSlot> Slots;
+
+	// one owner per block
+	TArray<AEnemy*> BlockOwners;
+
+	TArray<int32> FreeBlocks;
+
+	// head slot index of each bucket's list
+	int32 BucketHeads[NumBuckets];
+
+	int64 CurrentTick;
+
+	int32 NumActiveTimers;
+
+	// reused between advances
+	TArray<int32> ExpiredSlots;
+
+	FORCEINLINE static int32 SlotIndex(int32 Block, EEnemyTimer Timer) { return Block * (int32)EEnemyTimer::ET_MAX + (int32)Timer; }
+
+	void Link(int32 SlotIdx, int32 Bucket);
+
+	void Unlink(int32 SlotIdx);
+
+	void CancelSlot(int32 SlotIdx);
+};
@@ -0,0 +1,150 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Enemies/RagdollBudgetSubsystem.h"
+#include "../EscapeRoomProject.h"
+#include "../Enemies/Enemy.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Budget"), STAT_RagdollBudget, STATGROUP_EnemyAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulating Ragdolls"), STAT_SimulatingRagdolls, STATGROUP_EnemyAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Physical Hit Reacts"), STAT_PhysicalHitReacts, STATGROUP_EnemyAI);
+
+
+// sets default values
+URagdollBudgetSubsystem::URagdollBudgetSubsystem()
+{
+	MaxSimulatingRagdolls = 6;
+	MaxPhysicalHitReacts = 4;
+	PhysicalHitReactDuration = 0.75f;
+	PhysicalHitReactMaxDistance = 2500.f;
+	OffscreenDistanceScale = 3.f;
+	SettleSpeedThreshold = 5.f;
+	SettleTime = 0.5f;
+	MaxRagdollSimulationTime = 8.f;
+}
+
+
+TStatId URagdollBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URagdollBudgetSubsystem, STATGROUP_Tickables);
+}
+
+
+float URagdollBudgetSubsystem::GetPriorityScore(const AEnemy* Enemy) const
+{
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const float Distance = PlayerPawn ? FVector::Dist(Enemy->GetActorLocation(), PlayerPawn->GetActorLocation()) : 0.f;
+
+	return Enemy->WasRecentlyRendered(0.2f) ? Distance : Distance * OffscreenDistanceScale;
+}
+
+
+bool URagdollBudgetSubsystem::RequestRagdoll(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) { return false; }
+	if (ActiveRagdolls.ContainsByPredicate([Enemy](const FActiveRagdoll& Active) { return Active.Enemy == Enemy; })) { return true; }
+
+	// over budget: make room by freezing the least relevant ragdoll, if it is less relevant than this one
+	if (ActiveRagdolls.Num() >= MaxSimulatingRagdolls)
+	{
+		int32 LeastRelevantIndex = INDEX_NONE;
+		float LeastRelevantScore = -1.f;
+
+		for (int32 Index = 0; Index < ActiveRagdolls.Num(); ++Index)
+		{
+			const float Score = ActiveRagdolls[Index].Enemy ? GetPriorityScore(ActiveRagdolls[Index].Enemy) : MAX_flt;
+			if (Score > LeastRelevantScore)
+			{
+				LeastRelevantScore = Score;
+				LeastRelevantIndex = Index;
+			}
+		}
+
+		if (LeastRelevantIndex == INDEX_NONE || LeastRelevantScore <= GetPriorityScore(Enemy)) { return false; }
+
+		FreezeRagdollAt(LeastRelevantIndex);
+	}
+
+	FActiveRagdoll Active;
+	Active.Enemy = Enemy;
+	Active.StartTime = GetWorld()->GetTimeSeconds();
+	ActiveRagdolls.Add(Active);
+
+	return true;
+}
+
+
+bool URagdollBudgetSubsystem::RequestPhysicalHitReact(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) { return false; }
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// expire finished hit reacts
+	ActivePhysicalHitReacts.RemoveAllSwap([CurrentTime](const FActivePhysicalHitReact& Active) { return Active.Enemy == nullptr || Active.EndTime <= CurrentTime; });
+
+	// too far away to notice, or no slot free (the animated hit react still plays)
+	if (GetPriorityScore(Enemy) > PhysicalHitReactMaxDistance) { return false; }
+
+	// already reacting: just extend its slot
+	if (FActivePhysicalHitReact* Existing = ActivePhysicalHitReacts.FindByPredicate([Enemy](const FActivePhysicalHitReact& Active) { return Active.Enemy == Enemy; }))
+	{
+		Existing->EndTime = CurrentTime + PhysicalHitReactDuration;
+		return true;
+	}
+
+	if (ActivePhysicalHitReacts.Num() >= MaxPhysicalHitReacts) { return false; }
+
+	FActivePhysicalHitReact Active;
+	Active.Enemy = Enemy;
+	Active.EndTime = CurrentTime + PhysicalHitReactDuration;
+	ActivePhysicalHitReacts.Add(Active);
+
+	return true;
+}
+
+
+void URagdollBudgetSubsystem::ReleaseEnemy(AEnemy* Enemy)
+{
+	ActiveRagdolls.RemoveAllSwap([Enemy](const FActiveRagdoll& Active) { return Active.Enemy == Enemy; });
+	ActivePhysicalHitReacts.RemoveAllSwap([Enemy](const FActivePhysicalHitReact& Active) { return Active.Enemy == Enemy; });
+}
+
+
+void URagdollBudgetSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RagdollBudget);
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// freeze ragdolls that have come to rest (or simulated for too long)
+	for (int32 Index = ActiveRagdolls.Num() - 1; Index >= 0; --Index)
+	{
+		FActiveRagdoll& Active = ActiveRagdolls[Index];
+		if (Active.Enemy == nullptr)
+		{
+			ActiveRagdolls.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const USkeletalMeshComponent* MeshComp = Active.Enemy->GetMesh();
+		const bool bAtRest = !MeshComp->IsAnyRigidBodyAwake() || MeshComp->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettleSpeedThreshold);
+		Active.SettledTime = bAtRest ? Active.SettledTime + DeltaTime : 0.f;
+
+		if (Active.SettledTime >= SettleTime || CurrentTime - Active.StartTime >= MaxRagdollSimulationTime)
+		{ FreezeRagdollAt(Index); }
+	}
+
+	SET_DWORD_STAT(STAT_SimulatingRagdolls, ActiveRagdolls.Num());
+	SET_DWORD_STAT(STAT_PhysicalHitReacts, ActivePhysicalHitReacts.Num());
+}
+
+
+void URagdollBudgetSubsystem::FreezeRagdollAt(int32 Index)
+{
+	AEnemy* Enemy = ActiveRagdolls[Index].Enemy;
+	ActiveRagdolls.RemoveAtSwap(Index);
+
+	if (Enemy) { Enemy->FreezeRagdoll(); }
+}
@@ -0,0 +1,116 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RagdollBudgetSubsystem.generated.h"
+
+class AEnemy;
+
+// an enemy currently simulating a full ragdoll
+USTRUCT()
+struct FActiveRagdoll
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AEnemy* Enemy = nullptr;
+
+	double StartTime = 0.0;
+
+	// how long the body has been (nearly) at rest
+	float SettledTime = 0.f;
+};
+
+
+// an enemy currently playing a physics-driven hit react
+USTRUCT()
+struct FActivePhysicalHitReact
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AEnemy* Enemy = nullptr;
+
+	double EndTime = 0.0;
+};
+
+
+/**
+ *  caps how many enemy skeletons simulate physics at once (ragdolls + physical hit reacts). requests are prioritized
+ *  by distance to the player and whether the enemy is on screen; over budget, the least relevant ragdoll is frozen
+ *  to make room (or the request is refused). ragdolls that come to rest are frozen into a static posed corpse
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API URagdollBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	URagdollBudgetSubsystem();
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// may this enemy start simulating a ragdoll? (evicts a less relevant one if over budget)
+	bool RequestRagdoll(AEnemy* Enemy);
+
+	// may this enemy play a physical hit react right now?
+	bool RequestPhysicalHitReact(AEnemy* Enemy);
+
+	// stop tracking (enemy recycled / removed from play)
+	void ReleaseEnemy(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Physics Budget")
+	FORCEINLINE int32 GetNumSimulatingRagdolls() const { return ActiveRagdolls.Num(); }
+
+	/*
+	*  tuning
+	*/
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	int32 MaxSimulatingRagdolls;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	int32 MaxPhysicalHitReacts;
+
+	// how long a physical hit react is assumed to occupy its slot
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float PhysicalHitReactDuration;
+
+	// beyond this distance physical hit reacts are skipped outright (the animated hit react still plays)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float PhysicalHitReactMaxDistance;
+
+	// off-screen enemies count as this many times further away
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float OffscreenDistanceScale;
+
+	// a ragdoll whose root body moves slower than this (cm/s) is considered at rest
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float SettleSpeedThreshold;
+
+	// ... for this long before it is frozen
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float SettleTime;
+
+	// ragdolls are frozen after this long regardless
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Budget")
+	float MaxRagdollSimulationTime;
+
+protected:
+
+	UPROPERTY(Transient)
+	TArray<FActiveRagdoll> ActiveRagdolls;
+
+	UPROPERTY(Transient)
+	TArray<FActivePhysicalHitReact> ActivePhysicalHitReacts;
+
+	// lower is more relevant
+	float GetPriorityScore(const AEnemy* Enemy) const;
+
+	void FreezeRagdollAt(int32 Index);
+};
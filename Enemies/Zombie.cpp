@@ -3,11 +3,14 @@
 
 #include "../Enemies/Zombie.h"
 #include "../DebugMacros.h"
+#include "../Framework/AppearanceBuilderSubsystem.h"
 #include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
 
 AZombie::AZombie()
 {
 	ZombieType = EZombieType::EMS_MAX;
+	bMergeAppearance = true;
 
 	TopClothingMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("TopClothingMesh"));
 	TopClothingMesh->SetupAttachment(GetMesh());
@@ -22,7 +25,28 @@ AZombie::AZombie()
 
 void AZombie::BeginPlay()
 {
+	// the archetype decides the body type (set before BP BeginPlay picks appearance parts from it)
+	const EZombieType ArchetypeZombieType = GetArchetype().ZombieType;
+	if (ArchetypeZombieType != EZombieType::EMS_MAX) { ZombieType = ArchetypeZombieType; }
+
 	Super::BeginPlay();
+
+	// appearance parts are picked in BP BeginPlay; merge whatever was chosen (pooled zombies merge when acquired)
+	if (!bInEnemyPool) { RebuildAppearance(); }
+}
+
+
+void AZombie::RebuildAppearance()
+{
+	if (!bMergeAppearance) { return; }
+
+	UAppearanceBuilderSubsystem* AppearanceBuilder = UGameplayStatics::GetGameInstance(this)->GetSubsystem<UAppearanceBuilderSubsystem>();
+	if (AppearanceBuilder == nullptr) { return; }
+
+	AppearanceBuilder->BuildAppearance(GetMesh(), { TopClothingMesh, BottomClothingMesh, HairMesh }, MergedAppearance);
+
+	// the merged body is a new mesh to be hit on
+	BuildHitZones();
 }
 
 
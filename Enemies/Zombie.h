@@ -4,19 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "../Enemies/Enemy.h"
+#include "../Enemies/EnemyArchetype.h"
+#include "../Framework/AppearanceBuilderSubsystem.h"
 #include "Zombie.generated.h"
 
-UENUM(BlueprintType)
-enum class EZombieType : uint8
-{
-	EMS_MaleSkinny		UMETA(DisplayName = "MaleSkinny"),
-	EMS_MaleBloated		UMETA(DisplayName = "MaleBloated"),
-	EMS_FemaleSkinny	UMETA(DisplayName = "FemaleSkinny"),
-	EMS_FemaleBloated	UMETA(DisplayName = "FemaleBloated"),
-
-	EMS_MAX			UMETA(DisplayName = "DefaultMAX")
-};
-
 /**
  * 
  */
@@ -42,6 +33,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zombie")
 	class USkeletalMeshComponent* HairMesh;
 
+	// merge body/clothing/hair into a single skinned mesh (on by default)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zombie")
+	bool bMergeAppearance;
+
+	virtual void RebuildAppearance() override;
+
 protected:
 
 	// called when the game starts or when spawned
@@ -51,5 +48,10 @@ public:
 
 	// called every frame
 	virtual void Tick(float DeltaTime) override;
+
+private:
+
+	UPROPERTY(Transient)
+	FModularAppearance MergedAppearance;
 	
 };
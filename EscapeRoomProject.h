@@ -5,4 +5,10 @@
 #include "CoreMinimal.h"
 
 
-//#define COLLISION_WEAPON ECC_GameTraceChannel1
\ No newline at end of file
+//#define COLLISION_WEAPON ECC_GameTraceChannel1
+
+// stat group for the enemy AI managers (stat EnemyAI)
+DECLARE_STATS_GROUP(TEXT("EnemyAI"), STATGROUP_EnemyAI, STATCAT_Advanced);
+
+// stat group for the pooled effects (decals, FX, audio voices) (stat Effects)
+DECLARE_STATS_GROUP(TEXT("Effects"), STATGROUP_Effects, STATCAT_Advanced);
@@ -0,0 +1,112 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Framework/AppearanceBuilderSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "SkeletalMeshMerge.h"
+
+
+void UAppearanceBuilderSubsystem::BuildAppearance(USkeletalMeshComponent* Leader, const TArray<USkeletalMeshComponent*>& Parts, FModularAppearance& Appearance)
+{
+	if (Leader == nullptr) { return; }
+
+	// slot 0 is the leader, then each part
+	const int32 NumSlots = Parts.Num() + 1;
+	Appearance.SourceMeshes.SetNum(NumSlots);
+	Appearance.HiddenByMerge.SetNum(NumSlots);
+
+	auto GetSlotComponent = [&](int32 Slot) { return Slot == 0 ? Leader : Parts[Slot - 1]; };
+
+	// work out each slot's source mesh; a slot still holding a merged mesh keeps the source recorded last time
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		USkeletalMeshComponent* Component = GetSlotComponent(Slot);
+		USkeletalMesh* CurrentMesh = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+
+		if (!IsMergedMesh(CurrentMesh))
+		{ Appearance.SourceMeshes[Slot] = CurrentMesh; }
+
+		// un-hide anything a previous merge hid
+		if (Component && Appearance.HiddenByMerge[Slot])
+		{ Component->SetVisibility(true); }
+		Appearance.HiddenByMerge[Slot] = false;
+	}
+
+	// morph targets (e.g., the enemy mouth) don't survive a merge, so keep such a leader separate
+	USkeletalMesh* LeaderMesh = Appearance.SourceMeshes[0];
+	const bool bMergeLeader = LeaderMesh != nullptr && LeaderMesh->GetMorphTargets().Num() == 0;
+
+	// gather what's being merged (visible parts with a mesh only)
+	TArray<USkeletalMesh*> MergeMeshes;
+	TArray<int32> MergeSlots;
+	for (int32 Slot = bMergeLeader ? 0 : 1; Slot < NumSlots; ++Slot)
+	{
+		USkeletalMeshComponent* Component = GetSlotComponent(Slot);
+		if (Component == nullptr || Appearance.SourceMeshes[Slot] == nullptr || !Component->IsVisible()) { continue; }
+
+		MergeMeshes.Add(Appearance.SourceMeshes[Slot]);
+		MergeSlots.Add(Slot);
+	}
+
+	USkeletalMesh* MergedMesh = MergeMeshes.Num() >= 2 ? GetMergedMesh(LeaderMesh, MergeMeshes) : nullptr;
+
+	// nothing (worth) merging, or the merge failed: put every slot back on its own source mesh
+	if (MergedMesh == nullptr)
+	{
+		for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+		{
+			USkeletalMeshComponent* Component = GetSlotComponent(Slot);
+			if (Component && Component->GetSkeletalMeshAsset() != Appearance.SourceMeshes[Slot])
+			{ Component->SetSkeletalMesh(Appearance.SourceMeshes[Slot]); }
+		}
+		return;
+	}
+
+	// merged mesh goes on the first merged slot; the rest are hidden
+	USkeletalMeshComponent* TargetComponent = GetSlotComponent(MergeSlots[0]);
+	TargetComponent->SetSkeletalMesh(MergedMesh);
+
+	if (TargetComponent != Leader)
+	{ TargetComponent->SetLeaderPoseComponent(Leader); }
+
+	for (int32 Index = 1; Index < MergeSlots.Num(); ++Index)
+	{
+		GetSlotComponent(MergeSlots[Index])->SetVisibility(false);
+		Appearance.HiddenByMerge[MergeSlots[Index]] = true;
+	}
+}
+
+
+USkeletalMesh* UAppearanceBuilderSubsystem::GetMergedMesh(USkeletalMesh* LeaderMesh, const TArray<USkeletalMesh*>& SourceMeshes)
+{
+	if (LeaderMesh == nullptr || SourceMeshes.Num() == 0) { return nullptr; }
+
+	FAppearanceMergeKey Key;
+	Key.LeaderMesh = LeaderMesh;
+	Key.SourceMeshes = SourceMeshes;
+
+	if (USkeletalMesh** CachedMesh = MergedMeshCache.Find(Key))
+	{ return *CachedMesh; }
+
+	// outer is this subsystem (see IsMergedMesh); lives as long as the game instance
+	USkeletalMesh* MergedMesh = NewObject<USkeletalMesh>(this, NAME_None, RF_Transient);
+	MergedMesh->SetSkeleton(LeaderMesh->GetSkeleton());
+
+	// the merge doesn't carry a physics asset over; without one the merged mesh has no bodies (no per-bone hits, ragdoll, etc).
+	// the body's, not whichever part happens to be merged first (clothing / attachments have none, or the wrong one)
+	MergedMesh->SetPhysicsAsset(LeaderMesh->GetPhysicsAsset());
+
+	TArray<FSkelMeshMergeSectionMapping> SectionMappings;
+	FSkeletalMeshMerge Merger(MergedMesh, SourceMeshes, SectionMappings, 0);
+
+	if (!Merger.DoMerge())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AppearanceBuilder: failed to merge %d meshes onto %s"), SourceMeshes.Num(), *GetNameSafe(LeaderMesh));
+		MergedMesh = nullptr;
+	}
+
+	// failures are cached too, so they aren't retried every spawn
+	MergedMeshCache.Add(Key, MergedMesh);
+	return MergedMesh;
+}
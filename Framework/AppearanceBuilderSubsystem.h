@@ -0,0 +1,84 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "AppearanceBuilderSubsystem.generated.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+// the leader mesh + exact (ordered) list of source meshes a merged mesh was built from
+USTRUCT()
+struct FAppearanceMergeKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	USkeletalMesh* LeaderMesh = nullptr;
+
+	UPROPERTY()
+	TArray<USkeletalMesh*> SourceMeshes;
+
+	bool operator==(const FAppearanceMergeKey& Other) const { return LeaderMesh == Other.LeaderMesh && SourceMeshes == Other.SourceMeshes; }
+
+	friend uint32 GetTypeHash(const FAppearanceMergeKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.LeaderMesh);
+		for (const USkeletalMesh* Mesh : Key.SourceMeshes) { Hash = HashCombine(Hash, GetTypeHash(Mesh)); }
+		return Hash;
+	}
+};
+
+
+// per-actor record of what was merged, so an appearance can be rebuilt (e.g., after an enemy is recycled)
+USTRUCT(BlueprintType)
+struct FModularAppearance
+{
+	GENERATED_BODY()
+
+	// leader first, then parts; the mesh each slot had before merging
+	UPROPERTY(Transient)
+	TArray<USkeletalMesh*> SourceMeshes;
+
+	// parts hidden because their mesh was folded into the merged one
+	UPROPERTY(Transient)
+	TArray<bool> HiddenByMerge;
+};
+
+
+/**
+ *  merges modular skeletal mesh parts (body, clothing, hair...) into a single skeletal mesh,
+ *  so a character is skinned + drawn once instead of once per part. merged meshes are cached by
+ *  their source mesh combination, so repeated combinations cost nothing after the first
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UAppearanceBuilderSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 *  merge the leader + part components' meshes and apply the result. the leader is merged in too unless its mesh
+	 *  has morph targets (those aren't carried over by a merge), in which case the parts are merged onto the first part
+	 *  and driven by the leader's pose. parts folded into the merged mesh are hidden, not cleared, so the appearance can be rebuilt
+	 */
+	void BuildAppearance(USkeletalMeshComponent* Leader, const TArray<USkeletalMeshComponent*>& Parts, FModularAppearance& Appearance);
+
+	// merged mesh for this exact combination; built + cached on first request. skeleton + physics asset come from the
+	// leader (body) mesh, whether or not it is one of the merged meshes
+	USkeletalMesh* GetMergedMesh(USkeletalMesh* LeaderMesh, const TArray<USkeletalMesh*>& SourceMeshes);
+
+	// was this mesh produced by the builder?
+	FORCEINLINE bool IsMergedMesh(const USkeletalMesh* Mesh) const { return Mesh != nullptr && Mesh->GetOuter() == this; }
+
+	UFUNCTION(BlueprintPure, Category = "Appearance")
+	FORCEINLINE int32 GetNumCachedAppearances() const { return MergedMeshCache.Num(); }
+
+protected:
+
+	UPROPERTY(Transient)
+	TMap<FAppearanceMergeKey, USkeletalMesh*> MergedMeshCache;
+};
@@ -0,0 +1,144 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Framework/HitZoneSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "PhysicsEngine/BodySetup.h"
+
+
+template<typename ValueType>
+int32 UHitZoneSubsystem::FindOrAddMap(TArray<TMap<FName, ValueType>>& Maps, const TMap<FName, ValueType>& BoneMap)
+{
+	// only a handful of distinct maps (one per archetype / weapon type)
+	for (int32 MapId = 0; MapId < Maps.Num(); ++MapId)
+	{
+		if (Maps[MapId].OrderIndependentCompareEqual(BoneMap)) { return MapId; }
+	}
+
+	return Maps.Add(BoneMap);
+}
+
+
+template<typename ValueType>
+TSharedRef<THitZoneTable<ValueType>> UHitZoneSubsystem::CompileTable(const USkeletalMesh* Mesh, const TMap<FName, ValueType>& BoneMap, ValueType Default)
+{
+	const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	TSharedRef<THitZoneTable<ValueType>> Table = MakeShared<THitZoneTable<ValueType>>();
+	Table->Mesh = Mesh;
+	Table->Default = Default;
+	Table->Values.SetNumUninitialized(NumBones);
+
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		if (const ValueType* Mapped = BoneMap.Find(RefSkeleton.GetBoneName(BoneIndex)))
+		{
+			Table->Values[BoneIndex] = *Mapped;
+			continue;
+		}
+
+		// unmapped: inherit from the parent (already resolved), or the default at the root
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		Table->Values[BoneIndex] = ParentIndex != INDEX_NONE ? Table->Values[ParentIndex] : Default;
+	}
+
+	return Table;
+}
+
+
+int32 UHitZoneSubsystem::RegisterHitReactMap(const TMap<FName, EBoneHitReactValue>& BoneMap)
+{
+	return FindOrAddMap(HitReactMaps, BoneMap);
+}
+
+
+int32 UHitZoneSubsystem::RegisterDamageMap(const TMap<FName, float>& BoneModifiers)
+{
+	const int32 NumMaps = DamageMaps.Num();
+	const int32 MapId = FindOrAddMap(DamageMaps, BoneModifiers);
+	if (MapId < NumMaps) { return MapId; }
+
+	// new map: compile it for every mesh already known to be hittable
+	for (const TObjectKey<USkeletalMesh>& MeshKey : HitMeshes)
+	{
+		if (const USkeletalMesh* Mesh = MeshKey.ResolveObjectPtr())
+		{ DamageTables.Add(FHitZoneKey(MeshKey, MapId), CompileTable(Mesh, BoneModifiers, 1.f)); }
+	}
+
+	return MapId;
+}
+
+
+void UHitZoneSubsystem::RegisterHitMesh(const USkeletalMesh* Mesh)
+{
+	if (Mesh == nullptr) { return; }
+
+	const TObjectKey<USkeletalMesh> MeshKey(Mesh);
+	if (HitMeshes.Contains(MeshKey)) { return; }
+
+	// merged appearances come and go; forget the ones that have been collected
+	RemoveStaleMeshes();
+	HitMeshes.Add(MeshKey);
+
+	for (int32 MapId = 0; MapId < DamageMaps.Num(); ++MapId)
+	{ DamageTables.Add(FHitZoneKey(MeshKey, MapId), CompileTable(Mesh, DamageMaps[MapId], 1.f)); }
+}
+
+
+void UHitZoneSubsystem::RemoveStaleMeshes()
+{
+	const int32 NumRemoved = HitMeshes.RemoveAllSwap([](const TObjectKey<USkeletalMesh>& MeshKey) { return MeshKey.ResolveObjectPtr() == nullptr; });
+	if (NumRemoved == 0) { return; }
+
+	for (auto It = HitReactTables.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key.ResolveObjectPtr() == nullptr) { It.RemoveCurrent(); }
+	}
+
+	for (auto It = DamageTables.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key.ResolveObjectPtr() == nullptr) { It.RemoveCurrent(); }
+	}
+}
+
+
+TSharedPtr<const FHitReactZoneTable> UHitZoneSubsystem::GetHitReactTable(const USkeletalMesh* Mesh, int32 MapId)
+{
+	if (Mesh == nullptr || !HitReactMaps.IsValidIndex(MapId)) { return nullptr; }
+
+	const FHitZoneKey Key(Mesh, MapId);
+	if (const TSharedRef<FHitReactZoneTable>* Cached = HitReactTables.Find(Key)) { return *Cached; }
+
+	return HitReactTables.Add(Key, CompileTable(Mesh, HitReactMaps[MapId], EBoneHitReactValue::EBHR_MAX));
+}
+
+
+TSharedPtr<const FDamageZoneTable> UHitZoneSubsystem::GetDamageTable(const USkeletalMesh* Mesh, int32 MapId)
+{
+	if (Mesh == nullptr || !DamageMaps.IsValidIndex(MapId)) { return nullptr; }
+
+	const FHitZoneKey Key(Mesh, MapId);
+	if (const TSharedRef<FDamageZoneTable>* Cached = DamageTables.Find(Key)) { return *Cached; }
+
+	// a mesh nobody registered (e.g., a skeletal prop); compile on the spot
+	return DamageTables.Add(Key, CompileTable(Mesh, DamageMaps[MapId], 1.f));
+}
+
+
+int32 UHitZoneSubsystem::GetHitBoneIndex(const FHitResult& Hit)
+{
+	const USkeletalMeshComponent* MeshComp = Cast<USkeletalMeshComponent>(Hit.GetComponent());
+	if (MeshComp == nullptr || MeshComp->GetSkeletalMeshAsset() == nullptr) { return INDEX_NONE; }
+
+	// skeletal hits report the physics body index in Item; that body already knows its bone
+	if (MeshComp->Bodies.IsValidIndex(Hit.Item))
+	{
+		const FBodyInstance* Body = MeshComp->Bodies[Hit.Item];
+		if (Body && Body->BodySetup.IsValid() && Body->BodySetup->BoneName == Hit.BoneName) { return Body->InstanceBoneIndex; }
+	}
+
+	return MeshComp->GetBoneIndex(Hit.BoneName);
+}
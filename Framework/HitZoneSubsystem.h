@@ -0,0 +1,86 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "../Enemies/Enemy.h"
+#include "HitZoneSubsystem.generated.h"
+
+class USkeletalMesh;
+
+// a bone name -> value map resolved against one skeletal mesh: one entry per bone, unmapped bones inherit their parent's value
+template<typename ValueType>
+struct THitZoneTable
+{
+	TObjectKey<USkeletalMesh> Mesh;
+	TArray<ValueType> Values;
+	ValueType Default;
+
+	FORCEINLINE ValueType Get(int32 BoneIndex) const { return Values.IsValidIndex(BoneIndex) ? Values[BoneIndex] : Default; }
+};
+
+// hit reacts: EBHR_MAX marks a bone with no mapping on its whole parent chain
+typedef THitZoneTable<EBoneHitReactValue> FHitReactZoneTable;
+typedef THitZoneTable<float> FDamageZoneTable;
+
+
+/**
+ *  compiles bone-keyed hit data (archetype BoneHitReactMap, weapon BoneDamageModifiers) into dense per-mesh tables indexed
+ *  by bone index, so resolving a hit is an array lookup instead of a name search. maps are registered by content (equal
+ *  maps share an id, whoever owns them), and tables are cached per (mesh, map id). enemies register the meshes they can be
+ *  hit on + weapons their damage maps as they are set up, and every damage table for a known mesh/map pair is compiled
+ *  then, not on the first hit. everything is dropped with the world
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UHitZoneSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// id for this bone map's content (registering an equal map again returns the same id)
+	int32 RegisterHitReactMap(const TMap<FName, EBoneHitReactValue>& BoneMap);
+
+	// id for this damage modifier map's content; compiles its tables for every registered mesh
+	int32 RegisterDamageMap(const TMap<FName, float>& BoneModifiers);
+
+	// a mesh enemies can be hit on (e.g., a newly merged appearance); compiles every registered damage map against it
+	void RegisterHitMesh(const USkeletalMesh* Mesh);
+
+	// compiled hit react table for this mesh + registered map (compiled now if this pair hasn't been seen yet)
+	TSharedPtr<const FHitReactZoneTable> GetHitReactTable(const USkeletalMesh* Mesh, int32 MapId);
+
+	// compiled damage multiplier table for this mesh + registered map (1 for unmapped bones)
+	TSharedPtr<const FDamageZoneTable> GetDamageTable(const USkeletalMesh* Mesh, int32 MapId);
+
+	// mesh bone index of a skeletal mesh hit (via the physics body hit, falling back to the bone name); INDEX_NONE otherwise
+	static int32 GetHitBoneIndex(const FHitResult& Hit);
+
+	UFUNCTION(BlueprintPure, Category = "Hit Zones")
+	FORCEINLINE int32 GetNumCompiledTables() const { return HitReactTables.Num() + DamageTables.Num(); }
+
+protected:
+
+	typedef TPair<TObjectKey<USkeletalMesh>, int32> FHitZoneKey;
+
+	TArray<TMap<FName, EBoneHitReactValue>> HitReactMaps;
+	TArray<TMap<FName, float>> DamageMaps;
+
+	// meshes registered as hittable; entries whose mesh has been garbage collected are dropped (with their tables) on the next registration
+	TArray<TObjectKey<USkeletalMesh>> HitMeshes;
+
+	TMap<FHitZoneKey, TSharedRef<FHitReactZoneTable>> HitReactTables;
+	TMap<FHitZoneKey, TSharedRef<FDamageZoneTable>> DamageTables;
+
+	// index of an equal map in Maps, adding it if there is none
+	template<typename ValueType>
+	static int32 FindOrAddMap(TArray<TMap<FName, ValueType>>& Maps, const TMap<FName, ValueType>& BoneMap);
+
+	// one pass over the reference skeleton (parents always come before their children)
+	template<typename ValueType>
+	static TSharedRef<THitZoneTable<ValueType>> CompileTable(const USkeletalMesh* Mesh, const TMap<FName, ValueType>& BoneMap, ValueType Default);
+
+	void RemoveStaleMeshes();
+};
@@ -0,0 +1,75 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Framework/LegacyDataMigration.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+
+#if WITH_EDITORONLY_DATA
+void FLegacyDataMigration::CopyProperties(const UObject& Source, UObject& Target, const TMap<FName, FName>& Renames)
+{
+	// only the asset's own properties (not UPrimaryDataAsset's etc.)
+	for (TFieldIterator<FProperty> It(Target.GetClass(), EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		const FProperty* TargetProperty = *It;
+		const FName* LegacyName = Renames.Find(TargetProperty->GetFName());
+		const FProperty* SourceProperty = FindFProperty<FProperty>(Source.GetClass(), LegacyName ? *LegacyName : TargetProperty->GetFName());
+		if (SourceProperty == nullptr) { continue; }
+
+		const FSoftObjectProperty* SoftTarget = CastField<FSoftObjectProperty>(TargetProperty);
+		const FObjectProperty* HardSource = CastField<FObjectProperty>(SourceProperty);
+		const FBoolProperty* BoolTarget = CastField<FBoolProperty>(TargetProperty);
+		const FBoolProperty* BoolSource = CastField<FBoolProperty>(SourceProperty);
+
+		if (SoftTarget && HardSource)
+		{ SoftTarget->SetObjectPropertyValue_InContainer(&Target, HardSource->GetObjectPropertyValue_InContainer(&Source)); }
+
+		// legacy flags may be bitfields
+		else if (BoolTarget && BoolSource)
+		{ BoolTarget->SetPropertyValue_InContainer(&Target, BoolSource->GetPropertyValue_InContainer(&Source)); }
+
+		else if (SourceProperty->SameType(TargetProperty))
+		{ TargetProperty->CopyCompleteValue(TargetProperty->ContainerPtrToValuePtr<void>(&Target), SourceProperty->ContainerPtrToValuePtr<void>(&Source)); }
+	}
+}
+#endif
+
+
+#if WITH_EDITOR
+UObject* FLegacyDataMigration::CreateAsset(const UObject& Owner, UClass* AssetClass, const TCHAR* Suffix, const TMap<FName, FName>& Renames)
+{
+	// named after the blueprint (not its CDO) when migrating class defaults
+	FString AssetName = Owner.HasAnyFlags(RF_ClassDefaultObject) ? Owner.GetClass()->GetName() : Owner.GetName();
+	AssetName.RemoveFromEnd(TEXT("_C"));
+	AssetName += Suffix;
+	const FString PackageName = FPackageName::GetLongPackagePath(Owner.GetPackage()->GetName()) / AssetName;
+
+	if (FindPackage(nullptr, *PackageName) || FPackageName::DoesPackageExist(PackageName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s already exists; assign it instead"), *Owner.GetName(), *PackageName);
+		return nullptr;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UObject* Asset = NewObject<UObject>(Package, AssetClass, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	CopyProperties(Owner, *Asset, Renames);
+	FAssetRegistryModule::AssetCreated(Asset);
+	Package->MarkPackageDirty();
+
+	return Asset;
+}
+
+
+EDataValidationResult FLegacyDataMigration::ValidateAssigned(const UObject& Owner, const UObject* Asset, const TCHAR* AssetLabel, FDataValidationContext& Context)
+{
+	if (Asset) { return EDataValidationResult::Valid; }
+
+	Context.AddError(FText::FromString(FString::Printf(TEXT("%s has no %s; assign one, or create it from the legacy values with the migrate button"), *Owner.GetName(), AssetLabel)));
+	return EDataValidationResult::Invalid;
+}
+#endif
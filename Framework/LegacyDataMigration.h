@@ -0,0 +1,45 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+
+/**
+ *  moves designer data still authored on an object (weapon, enemy, item) from before shared data assets (archetypes,
+ *  definitions) onto one: each legacy property is copied onto the asset property of the same name, or of the name it
+ *  was renamed to. hard references become the asset's soft references
+ */
+struct ESCAPEROOMPROJECT_API FLegacyDataMigration
+{
+#if WITH_EDITORONLY_DATA
+	// copy Source's legacy properties onto Target's; Renames maps a target property name to its legacy name where they differ
+	static void CopyProperties(const UObject& Source, UObject& Target, const TMap<FName, FName>& Renames = {});
+
+	// a transient asset built from Owner's legacy properties, so an object that was never migrated still plays as authored
+	template<typename AssetType>
+	static AssetType* MakeTransientAsset(const UObject& Owner, const TMap<FName, FName>& Renames = {})
+	{
+		AssetType* Asset = NewObject<AssetType>(const_cast<UObject*>(&Owner), NAME_None, RF_Transient);
+		CopyProperties(Owner, *Asset, Renames);
+		return Asset;
+	}
+#endif
+
+#if WITH_EDITOR
+	// a new asset next to Owner built from its legacy properties (e.g., /Game/Weapons/BP_Pistol + "_Archetype" ->
+	// /Game/Weapons/BP_Pistol_Archetype); nullptr if that asset already exists
+	template<typename AssetType>
+	static AssetType* CreateAsset(const UObject& Owner, const TCHAR* Suffix, const TMap<FName, FName>& Renames = {})
+	{ return CastChecked<AssetType>(CreateAsset(Owner, AssetType::StaticClass(), Suffix, Renames), ECastCheckedType::NullAllowed); }
+
+	static UObject* CreateAsset(const UObject& Owner, UClass* AssetClass, const TCHAR* Suffix, const TMap<FName, FName>& Renames = {});
+
+	// an error (pointing at the migrate button) if Owner has no shared data asset assigned
+	static EDataValidationResult ValidateAssigned(const UObject& Owner, const UObject* Asset, const TCHAR* AssetLabel, FDataValidationContext& Context);
+#endif
+};
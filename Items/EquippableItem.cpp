@@ -10,7 +10,6 @@
 
 UEquippableItem::UEquippableItem()
 {
-	bStackable = false;
 	bEquipped = false;
 	UseActionText = LOCTEXT("ItemUseActionText", "Equip");
 	EquipUnequipSoundVolumeMultiplier = 0.35f;
@@ -57,8 +56,12 @@ void UEquippableItem::EquipStatusChanged()
 		{ Unequip(PlayerCharacter); }
 	}
 
-	// tell UI to update
-	OnItemModified.Broadcast();
+	// tell UI to update (batched with the rest of the inventory's changes, if held)
+	if (OwningInventory)
+	{ OwningInventory->MarkItemChanged(this); }
+
+	else
+	{ OnItemModified.Broadcast(); }
 }
 
 
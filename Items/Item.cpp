@@ -2,9 +2,14 @@
 
 
 #include "../Items/Item.h"
+#include "../Items/ItemAssetStreamer.h"
+#include "../Framework/LegacyDataMigration.h"
 #include "../Components/InventoryComponent.h"
 #include "../PlayerCharacter/PlayerCharacter.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Sound/SoundBase.h"
 
 
 #if WITH_EDITOR
@@ -16,21 +21,93 @@ void UItem::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChanged
 
 	// UPROPERTY clamping doesn't support using a variable to clamp, so doing it here instead (if Quantity is what changed)
 	if (ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UItem, Quantity))
-	{ Quantity = FMath::Clamp(Quantity, 1, bStackable ? MaxStackSize : 1); }
+	{ Quantity = FMath::Clamp(Quantity, 1, IsStackable() ? GetMaxStackSize() : 1); }
 }
 #endif
 
 // sets default values
 UItem::UItem()
 {
+	Quantity = 1;
+	bDisableOnPickupSound = false;
+	Definition = nullptr;
+
+#if WITH_EDITORONLY_DATA
+	// legacy static defaults, unchanged: older blueprints only saved where they differed from these
 	ItemDisplayName = FText::FromString(TEXT("Item Name"));
 	ItemDisplayDescription = FText::FromString(TEXT("Item Description"));
 	bStackable = false;
-	Quantity = 1;
 	MaxStackSize = 2;
 	PickupSoundVolumeMultiplier = 0.35f;
-	bDisableOnPickupSound = false;
+	PickupMesh = nullptr;
+	ItemThumbnail = nullptr;
+	ExaminationMesh = nullptr;
+	PickupSound = nullptr;
+	LegacyDefinition = nullptr;
+#endif
+}
+
+
+void UItem::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// caught by data validation (see IsDataValid); the fallback only keeps a broken item from crashing
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{ ensureMsgf(Definition, TEXT("%s has no item definition; using fallback values"), *GetClass()->GetName()); }
+}
+
+
+#if WITH_EDITORONLY_DATA
+// definition properties whose legacy field on the item had another name (the rest match)
+static const TMap<FName, FName>& GetLegacyFieldNames()
+{
+	static const TMap<FName, FName> LegacyFieldNames =
+	{
+		{ FName(TEXT("DisplayName")), FName(TEXT("ItemDisplayName")) },
+		{ FName(TEXT("DisplayDescription")), FName(TEXT("ItemDisplayDescription")) },
+		{ FName(TEXT("Thumbnail")), FName(TEXT("ItemThumbnail")) }
+	};
+
+	return LegacyFieldNames;
+}
+#endif
+
+
+const UItemDefinition& UItem::GetDefinition() const
+{
+	if (Definition) { return *Definition; }
+
+#if WITH_EDITORONLY_DATA
+	// not migrated yet (see MigrateToDefinition); keep playing as authored
+	if (LegacyDefinition == nullptr) { LegacyDefinition = FLegacyDataMigration::MakeTransientAsset<UItemDefinition>(*this, GetLegacyFieldNames()); }
+	return *LegacyDefinition;
+#else
+	return *GetDefault<UItemDefinition>();
+#endif
+}
+
+
+#if WITH_EDITOR
+void UItem::MigrateToDefinition()
+{
+	if (Definition) { return; }
+
+	UItemDefinition* NewDefinition = FLegacyDataMigration::CreateAsset<UItemDefinition>(*this, TEXT("_Definition"), GetLegacyFieldNames());
+	if (NewDefinition == nullptr) { return; }
+
+	Modify();
+	Definition = NewDefinition;
+	LegacyDefinition = nullptr;
+	MarkPackageDirty();
+}
+
+
+EDataValidationResult UItem::IsDataValid(FDataValidationContext& Context) const
+{
+	return CombineDataValidationResults(Super::IsDataValid(Context), FLegacyDataMigration::ValidateAssigned(*this, Definition, TEXT("item definition"), Context));
 }
+#endif
 
 // function to be overwritten by classes inheriting from this class
 void UItem::Use(APlayerCharacter* PlayerCharacter)
@@ -42,17 +119,59 @@ void UItem::Use(APlayerCharacter* PlayerCharacter)
 // 1 and either MaxStackSize or 1, depending on whether or not the object is stackable.
 void UItem::SetQuantity(const int32 NewQuantity)
 {
-	if (NewQuantity != Quantity && bStackable) 
+	if (NewQuantity != Quantity && IsStackable()) 
 	{
-		Quantity = FMath::Clamp(NewQuantity, 0, MaxStackSize);
-		OnItemModified.Broadcast();
+		const int32 OldQuantity = Quantity;
+		Quantity = FMath::Clamp(NewQuantity, 0, GetMaxStackSize());
+
+		// keep the owning inventory's per-class quantities current; it also notifies (batched) for items it holds
+		if (OwningInventory)
+		{ OwningInventory->OnItemQuantityChanged(this, OldQuantity); }
+
+		else
+		{ OnItemModified.Broadcast(); }
 	}
 }
 
+UTexture2D* UItem::GetThumbnail() const
+{
+	return GetThumbnailAsset().Get();
+}
+
+
+UStaticMesh* UItem::GetPickupMesh() const
+{
+	return GetPickupMeshAsset().Get();
+}
+
+
+UStaticMesh* UItem::GetExaminationMesh() const
+{
+	return GetExaminationMeshAsset().Get();
+}
+
+
+USoundBase* UItem::GetPickupSound() const
+{
+	return GetPickupSoundAsset().Get();
+}
+
+
 // function to be called by Inventory class when item is added to inventory
 void UItem::AddedToInventory(class UInventoryComponent* Inventory, int32 QuantityAdded)
 {
-	// play pickup sound
-	if (PickupSound && !bDisableOnPickupSound)
-	{ UGameplayStatics::PlaySound2D(GetWorld(), PickupSound, PickupSoundVolumeMultiplier); }
+	if (bDisableOnPickupSound || GetPickupSoundAsset().IsNull()) { return; }
+
+	// play pickup sound (normally already streamed in with the pickup's mesh; if not, play it once it arrives)
+	if (USoundBase* Sound = GetPickupSound())
+	{ UGameplayStatics::PlaySound2D(GetWorld(), Sound, GetPickupSoundVolumeMultiplier()); }
+
+	else if (UItemAssetStreamer* Streamer = UItemAssetStreamer::Get(this))
+	{
+		Streamer->RequestAssets({ GetPickupSoundAsset().ToSoftObjectPath() }, FStreamableDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (USoundBase* Sound = GetPickupSound())
+			{ UGameplayStatics::PlaySound2D(GetWorld(), Sound, GetPickupSoundVolumeMultiplier()); }
+		}));
+	}
 }
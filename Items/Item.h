@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "../Items/ItemDefinition.h"
 #include "Item.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnItemModified);
@@ -25,75 +26,153 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "Item")
 	class UInventoryComponent* OwningInventory;
 
-	// inventory display name for this item
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	FText ItemDisplayName;
+	// shared static data for this kind of item (names, meshes, sounds, stacking rules); an item itself only carries its
+	// runtime state (quantity, owner, use text, pickup sound toggle). required: an item without one fails data validation
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	UItemDefinition* Definition;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, noclear, Category = "Item")
 	TSubclassOf<class UItem> LookupClass;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item", meta = (EditCondition = bStackable))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item")
 	int32 Quantity;
 
-	// whether or not this item can be stacked in the inventory
+	// the verb text for using the item (e.g., equip, eat, etc); overrides the definition's when set
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item")
-	bool bStackable;
+	FText UseActionText;
 
-	// maximum size a stack of these items can be
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item", meta = (ClampMin = 2, EditCondition = bStackable))
-	int32 MaxStackSize;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
+	bool bDisableOnPickupSound;
 
-	// description of the item to display in the inventory when item is selected
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item", meta = (MultiLine = true))
-	FText ItemDisplayDescription;
+	UPROPERTY(BlueprintAssignable)
+	FOnItemModified OnItemModified;
 
-	// mesh to display for this item's in-world pickup
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	UStaticMesh* PickupMesh;
+	UFUNCTION(Category = "Item")
+	FORCEINLINE bool ShouldNotifyOnAdd() const { return bDisableOnPickupSound; }
 
-	// thumbnail inventory picture for this item
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	class UTexture2D* ItemThumbnail;
+	/*
+	*  static data, read through the definition. asset getters return nullptr until the asset has been streamed in
+	*  (see UItemAssetStreamer)
+	*/
 
-	// mesh to display when examining this item in inventory
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	UStaticMesh* ExaminationMesh;
+	// Definition, or a read-only fallback if it is missing anyway (the legacy fields in the editor, class defaults in a cooked build)
+	const UItemDefinition& GetDefinition() const;
 
-	// for adjusting examination mesh location relative to scene capture camera
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	FVector ExaminationMeshOffset;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE FText GetDisplayName() const { return GetDefinition().DisplayName; }
 
-	// for adjusting examination mesh rotation
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	FRotator ExaminationMeshRotation;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE FText GetDisplayDescription() const { return GetDefinition().DisplayDescription; }
 
-	// the verb text for using the item (e.g., equip, eat, etc)
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Item")
-	FText UseActionText;
+	// runtime text (e.g., equip / unequip) set on the instance wins over the definition's
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE FText GetUseActionText() const { return UseActionText.IsEmpty() ? GetDefinition().UseActionText : UseActionText; }
 
-	// on-pickup sound
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	class USoundBase* PickupSound;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	UTexture2D* GetThumbnail() const;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	bool bDisableOnPickupSound;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	UStaticMesh* GetPickupMesh() const;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
-	float PickupSoundVolumeMultiplier;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	UStaticMesh* GetExaminationMesh() const;
 
-	UPROPERTY(BlueprintAssignable)
-	FOnItemModified OnItemModified;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE FVector GetExaminationMeshOffset() const { return GetDefinition().ExaminationMeshOffset; }
 
-	UFUNCTION(Category = "Item")
-	FORCEINLINE bool ShouldNotifyOnAdd() const { return bDisableOnPickupSound; }
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE FRotator GetExaminationMeshRotation() const { return GetDefinition().ExaminationMeshRotation; }
+
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE bool IsStackable() const { return GetDefinition().bStackable; }
+
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE int32 GetMaxStackSize() const { return GetDefinition().MaxStackSize; }
 
+	UFUNCTION(BlueprintPure, Category = "Item")
+	USoundBase* GetPickupSound() const;
+
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FORCEINLINE float GetPickupSoundVolumeMultiplier() const { return GetDefinition().PickupSoundVolumeMultiplier; }
+
+	// for blueprints that read the item's former static fields whose names changed on the definition (the others, and
+	// bStackable, map onto the getters above)
+	UFUNCTION(BlueprintPure, Category = "Item", meta = (DisplayName = "Item Display Name", DeprecatedFunction, DeprecationMessage = "Use Get Display Name"))
+	FORCEINLINE FText GetItemDisplayName() const { return GetDisplayName(); }
+
+	UFUNCTION(BlueprintPure, Category = "Item", meta = (DisplayName = "Item Display Description", DeprecatedFunction, DeprecationMessage = "Use Get Display Description"))
+	FORCEINLINE FText GetItemDisplayDescription() const { return GetDisplayDescription(); }
+
+	UFUNCTION(BlueprintPure, Category = "Item", meta = (DisplayName = "Item Thumbnail", DeprecatedFunction, DeprecationMessage = "Use Get Thumbnail"))
+	FORCEINLINE UTexture2D* GetItemThumbnail() const { return GetThumbnail(); }
+
+	// soft references, for streaming
+	FORCEINLINE TSoftObjectPtr<UTexture2D> GetThumbnailAsset() const { return GetDefinition().Thumbnail; }
+	FORCEINLINE TSoftObjectPtr<UStaticMesh> GetPickupMeshAsset() const { return GetDefinition().PickupMesh; }
+	FORCEINLINE TSoftObjectPtr<UStaticMesh> GetExaminationMeshAsset() const { return GetDefinition().ExaminationMesh; }
+	FORCEINLINE TSoftObjectPtr<USoundBase> GetPickupSoundAsset() const { return GetDefinition().PickupSound; }
+
+
+#if WITH_EDITOR
+	// move this item's legacy static fields (below) onto a new definition asset next to it, and point it there
+	UFUNCTION(CallInEditor, Category = "Item")
+	void MigrateToDefinition();
+
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
 
 protected:
+
+	virtual void PostInitProperties() override;
 	
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
+#if WITH_EDITORONLY_DATA
+	/*
+	*  legacy static fields, from before item definitions. not edited or read at runtime any more; only still loaded
+	*  from older blueprints so MigrateToDefinition can move them onto a definition
+	*/
+
+	UPROPERTY()
+	FText ItemDisplayName;
+
+	UPROPERTY()
+	FText ItemDisplayDescription;
+
+	UPROPERTY()
+	bool bStackable;
+
+	UPROPERTY()
+	int32 MaxStackSize;
+
+	UPROPERTY()
+	UStaticMesh* PickupMesh;
+
+	UPROPERTY()
+	class UTexture2D* ItemThumbnail;
+
+	UPROPERTY()
+	UStaticMesh* ExaminationMesh;
+
+	UPROPERTY()
+	FVector ExaminationMeshOffset;
+
+	UPROPERTY()
+	FRotator ExaminationMeshRotation;
+
+	UPROPERTY()
+	class USoundBase* PickupSound;
+
+	UPROPERTY()
+	float PickupSoundVolumeMultiplier;
+
+	// built from the legacy fields for items without a definition, so they still play as authored in the editor
+	UPROPERTY(Transient)
+	mutable UItemDefinition* LegacyDefinition;
+#endif
+
 public:
 	
 	virtual void Use(class APlayerCharacter* PlayerCharacter);
@@ -0,0 +1,162 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Items/ItemAssetStreamer.h"
+#include "../Items/Item.h"
+#include "../Components/InventoryComponent.h"
+#include "../World/Pickup.h"
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+
+
+// sets default values
+UItemAssetStreamer::UItemAssetStreamer()
+{
+	MaxCachedAssets = 32;
+	PickupStreamInDistance = 6000.f;
+	ProximityCheckInterval = 0.25f;
+}
+
+
+void UItemAssetStreamer::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	AssetCache.Empty(FMath::Max(MaxCachedAssets, 1));
+}
+
+
+void UItemAssetStreamer::Deinitialize()
+{
+	GetGameInstance()->GetTimerManager().ClearTimer(TimerHandle_ProximityCheck);
+	PendingPickups.Empty();
+	AssetCache.Empty(FMath::Max(MaxCachedAssets, 1));
+
+	Super::Deinitialize();
+}
+
+
+UItemAssetStreamer* UItemAssetStreamer::Get(const UObject* WorldContextObject)
+{
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+	return GameInstance ? GameInstance->GetSubsystem<UItemAssetStreamer>() : nullptr;
+}
+
+
+void UItemAssetStreamer::RequestAssets(const TArray<FSoftObjectPath>& Assets, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FSoftObjectPath& Asset : Assets)
+	{
+		if (Asset.IsNull()) { continue; }
+
+		// cached: mark as most recently used; only still-loading entries are requested again (the streamable manager merges them)
+		const TSharedPtr<FStreamableHandle>* CachedHandle = AssetCache.FindAndTouch(Asset);
+		if (CachedHandle == nullptr || !(*CachedHandle)->HasLoadCompleted())
+		{ AssetsToLoad.AddUnique(Asset); }
+	}
+
+	// all already resident
+	if (AssetsToLoad.Num() == 0)
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, OnLoaded);
+	if (!Handle.IsValid())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	// every asset of the request shares the handle; it is released once the last of them is evicted
+	for (const FSoftObjectPath& Asset : AssetsToLoad)
+	{ AssetCache.Add(Asset, Handle); }
+}
+
+
+void UItemAssetStreamer::LoadThumbnails(const UInventoryComponent* Inventory, const FOnItemAssetsLoaded& OnLoaded)
+{
+	TArray<FSoftObjectPath> Assets;
+	if (Inventory)
+	{
+		for (const UItem* Item : Inventory->GetItems())
+		{
+			if (Item) { Assets.Add(Item->GetThumbnailAsset().ToSoftObjectPath()); }
+		}
+	}
+
+	RequestAssets(Assets, FStreamableDelegate::CreateWeakLambda(this, [OnLoaded]() { OnLoaded.ExecuteIfBound(); }));
+}
+
+
+void UItemAssetStreamer::LoadExaminationMesh(const UItem* Item, const FOnItemAssetsLoaded& OnLoaded)
+{
+	TArray<FSoftObjectPath> Assets;
+	if (Item) { Assets.Add(Item->GetExaminationMeshAsset().ToSoftObjectPath()); }
+
+	RequestAssets(Assets, FStreamableDelegate::CreateWeakLambda(this, [OnLoaded]() { OnLoaded.ExecuteIfBound(); }));
+}
+
+
+void UItemAssetStreamer::LoadPickupAssets(const UItem* Item, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> Assets;
+	if (Item)
+	{
+		Assets.Add(Item->GetPickupMeshAsset().ToSoftObjectPath());
+		Assets.Add(Item->GetPickupSoundAsset().ToSoftObjectPath());
+	}
+
+	RequestAssets(Assets, OnLoaded);
+}
+
+
+void UItemAssetStreamer::RegisterPickup(APickup* Pickup)
+{
+	if (Pickup == nullptr) { return; }
+
+	PendingPickups.AddUnique(Pickup);
+
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (!TimerManager.IsTimerActive(TimerHandle_ProximityCheck))
+	{ TimerManager.SetTimer(TimerHandle_ProximityCheck, this, &UItemAssetStreamer::CheckPickupProximity, ProximityCheckInterval, true); }
+}
+
+
+void UItemAssetStreamer::UnregisterPickup(APickup* Pickup)
+{
+	PendingPickups.RemoveSingleSwap(Pickup);
+}
+
+
+// stream in the mesh of every pending pickup the player has come close enough to
+void UItemAssetStreamer::CheckPickupProximity()
+{
+	const APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
+	const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (PlayerPawn == nullptr) { return; }
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const float StreamInDistanceSquared = FMath::Square(PickupStreamInDistance);
+
+	for (int32 Index = PendingPickups.Num() - 1; Index >= 0; --Index)
+	{
+		APickup* Pickup = PendingPickups[Index].Get();
+		if (Pickup == nullptr || Pickup->GetItem() == nullptr)
+		{
+			PendingPickups.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (FVector::DistSquared(Pickup->GetActorLocation(), PlayerLocation) <= StreamInDistanceSquared)
+		{
+			PendingPickups.RemoveAtSwap(Index);
+			LoadPickupAssets(Pickup->GetItem(), FStreamableDelegate::CreateUObject(Pickup, &APickup::OnPickupAssetsLoaded));
+		}
+	}
+
+	if (PendingPickups.Num() == 0)
+	{ GetGameInstance()->GetTimerManager().ClearTimer(TimerHandle_ProximityCheck); }
+}
@@ -0,0 +1,87 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/LruCache.h"
+#include "Engine/StreamableManager.h"
+#include "ItemAssetStreamer.generated.h"
+
+class APickup;
+class UInventoryComponent;
+class UItem;
+
+DECLARE_DYNAMIC_DELEGATE(FOnItemAssetsLoaded);
+
+
+/**
+ *  streams in items' soft visual / audio assets only when they are about to be seen or heard: thumbnails when the
+ *  inventory is opened, examination meshes when an item is examined, and pickup meshes (+ pickup sounds) as the player
+ *  approaches a pickup. recently used assets are kept resident in a small LRU cache; anything evicted from it stays
+ *  loaded only for as long as something else (e.g., a widget or mesh component) still references it
+ */
+UCLASS()
+class ESCAPEROOMPROJECT_API UItemAssetStreamer : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UItemAssetStreamer();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UItemAssetStreamer* Get(const UObject* WorldContextObject);
+
+	// stream in (and cache) these assets; OnLoaded fires once they are all resident (right away if they already are)
+	void RequestAssets(const TArray<FSoftObjectPath>& Assets, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	// thumbnails for every item in this inventory (call when the inventory UI opens)
+	UFUNCTION(BlueprintCallable, Category = "Item Streaming")
+	void LoadThumbnails(const UInventoryComponent* Inventory, const FOnItemAssetsLoaded& OnLoaded);
+
+	// examination mesh for this item (call when the item is examined)
+	UFUNCTION(BlueprintCallable, Category = "Item Streaming")
+	void LoadExaminationMesh(const UItem* Item, const FOnItemAssetsLoaded& OnLoaded);
+
+	// pickup mesh + pickup sound for this item
+	void LoadPickupAssets(const UItem* Item, FStreamableDelegate OnLoaded);
+
+	// pickups waiting for the player to come within PickupStreamInDistance before their mesh is streamed in
+	void RegisterPickup(APickup* Pickup);
+	void UnregisterPickup(APickup* Pickup);
+
+	UFUNCTION(BlueprintPure, Category = "Item Streaming")
+	FORCEINLINE int32 GetNumCachedAssets() const { return AssetCache.Num(); }
+
+	/*
+	*  tuning
+	*/
+
+	// how many recently used assets are kept resident
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Streaming")
+	int32 MaxCachedAssets;
+
+	// pickups closer than this to the player have their mesh streamed in (well beyond interaction range, so the swap from
+	// the placeholder mesh happens before the pickup is noticeable)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Streaming")
+	float PickupStreamInDistance;
+
+	// how often pending pickups are checked against the player's position
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Streaming")
+	float ProximityCheckInterval;
+
+protected:
+
+	// resident assets, most recently used first; evicting an entry drops its streamable handle
+	TLruCache<FSoftObjectPath, TSharedPtr<FStreamableHandle>> AssetCache;
+
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<APickup>> PendingPickups;
+
+	FTimerHandle TimerHandle_ProximityCheck;
+
+	void CheckPickupProximity();
+};
@@ -0,0 +1,22 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Items/ItemDefinition.h"
+
+
+// sets default values
+UItemDefinition::UItemDefinition()
+{
+	DisplayName = FText::FromString(TEXT("Item Name"));
+	DisplayDescription = FText::FromString(TEXT("Item Description"));
+	bStackable = false;
+	MaxStackSize = 2;
+	PickupSoundVolumeMultiplier = 0.35f;
+}
+
+
+FPrimaryAssetId UItemDefinition::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FPrimaryAssetType("ItemDefinition"), GetFName());
+}
+
@@ -0,0 +1,87 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ItemDefinition.generated.h"
+
+class USoundBase;
+class UStaticMesh;
+class UTexture2D;
+
+/**
+ *  shared, read-only data for one kind of item (names, meshes, sounds, stacking rules). every UItem of that kind
+ *  points at the same definition, so an item instance only carries its runtime state (quantity, owner, etc.).
+ *  visual / audio assets are soft and streamed in on demand by UItemAssetStreamer
+ */
+UCLASS(BlueprintType)
+class ESCAPEROOMPROJECT_API UItemDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UItemDefinition();
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	/*
+	*  display
+	*/
+
+	// inventory display name for this item
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	FText DisplayName;
+
+	// description of the item to display in the inventory when item is selected
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display", meta = (MultiLine = true))
+	FText DisplayDescription;
+
+	// the verb text for using the item (e.g., equip, eat, etc)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	FText UseActionText;
+
+	// thumbnail inventory picture for this item (streamed in when the inventory is opened)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	TSoftObjectPtr<UTexture2D> Thumbnail;
+
+	// mesh to display for this item's in-world pickup (streamed in as the player approaches)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	TSoftObjectPtr<UStaticMesh> PickupMesh;
+
+	// mesh to display when examining this item in inventory (streamed in when the item is examined)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	TSoftObjectPtr<UStaticMesh> ExaminationMesh;
+
+	// for adjusting examination mesh location relative to scene capture camera
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	FVector ExaminationMeshOffset;
+
+	// for adjusting examination mesh rotation
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Display")
+	FRotator ExaminationMeshRotation;
+
+	/*
+	*  stacking
+	*/
+
+	// whether or not this item can be stacked in the inventory
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stacking")
+	bool bStackable;
+
+	// maximum size a stack of these items can be
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stacking", meta = (ClampMin = 2, EditCondition = bStackable))
+	int32 MaxStackSize;
+
+	/*
+	*  audio
+	*/
+
+	// on-pickup sound (streamed in with the pickup mesh)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Audio")
+	TSoftObjectPtr<USoundBase> PickupSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Audio")
+	float PickupSoundVolumeMultiplier;
+};
@@ -7,6 +7,7 @@
 #include "../Components/InventoryComponent.h"
 #include "../DebugMacros.h"
 #include "../Enemies/Enemy.h"
+#include "../Framework/AppearanceBuilderSubsystem.h"
 #include "../Items/AccessoryItem.h"
 #include "../Items/WeaponItem.h"
 #include "../Weapons/Weapon.h"
@@ -57,6 +58,9 @@ APlayerCharacter::APlayerCharacter()
 	HairMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("HairMesh"));
 	HairMesh->SetupAttachment(GetMesh(), FName("Hair_Socket"));
 
+	// chest/hands/legs/feet are merged into a single mesh on BeginPlay (see RebuildAppearance)
+	bMergeModularMeshes = true;
+
 	/**
 	*   create camera and noise components
 	*/
@@ -187,6 +191,23 @@ void APlayerCharacter::BeginPlay()
 	Super::BeginPlay();	
 
 	Tags.Add(FName("Player"));
+
+	DeathBackwardSections.Build(DeathMontage, DeathMontageBackwardOnlySections);
+	DeathForwardSections.Build(DeathMontage, DeathMontageForwardOnlySections);
+	HitReactSections.Build(HitReactsMontage);
+
+	RebuildAppearance();
+}
+
+
+void APlayerCharacter::RebuildAppearance()
+{
+	if (!bMergeModularMeshes) { return; }
+
+	UAppearanceBuilderSubsystem* AppearanceBuilder = UGameplayStatics::GetGameInstance(this)->GetSubsystem<UAppearanceBuilderSubsystem>();
+	if (AppearanceBuilder == nullptr) { return; }
+
+	AppearanceBuilder->BuildAppearance(GetMesh(), { ChestMesh, HandsMesh, LegsMesh, FeetMesh }, MergedAppearance);
 }
 
 
@@ -737,8 +758,10 @@ void APlayerCharacter::UseItem(class UItem* Item)
 		// can't use an item you don't have
 		if (PlayerInventory && !PlayerInventory->FindItem(Item)) { return; }
 
+		// whatever using the item changes goes out as one inventory update
+		FInventoryChangeBatchScope ChangeBatch(PlayerInventory);
 		Item->Use(this);
-		PlayerInventory->OnInventoryModified.Broadcast();
+		PlayerInventory->MarkItemChanged(Item);
 	}
 }
 
@@ -993,8 +1016,7 @@ float APlayerCharacter::TakeDamage(float DamageAmount, struct FDamageEvent const
 			UGameplayStatics::PlaySoundAtLocation(GetWorld(), RandomHurtCue, GetActorLocation(), 1.f);
 			
 			// play the appropriate hit reaction anim
-			FPlayerHitReact HitReactData = GetPlayerHitReactToPlay();
-			PlayAnimMontage(HitReactData.MontageToPlay, 1.f, HitReactData.SectionToPlay);
+			GetPlayerHitReactToPlay().Play(GetMesh()->GetAnimInstance());
 		
 			return DamageAmount;
 		}
@@ -1052,31 +1074,17 @@ float APlayerCharacter::ModifyHealth(const float Delta)
 }
 
 
-void APlayerCharacter::PlayMontageSection(UAnimMontage* Montage, const FName& SectionName)
-{
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance && Montage)
-	{
-		AnimInstance->Montage_Play(Montage);
-		AnimInstance->Montage_JumpToSection(SectionName, Montage);
-	}
-}
-
-int32 APlayerCharacter::PlayRandomMontageSection(UAnimMontage* Montage, const TArray<FName>& SectionNames)
+float APlayerCharacter::PlayRandomMontageSection(const FMontageSectionList& SectionList)
 {
-	if (SectionNames.Num() <= 0) { return -1; }
-
-	const int32 MaxSectionIndex = SectionNames.Num() - 1;
-	const int32 Selection = FMath::RandRange(0, MaxSectionIndex);
-	PlayMontageSection(Montage, SectionNames[Selection]);
-	return Selection;
+	const FMontageSection* Section = SectionList.PickRandom();
+	return Section ? Section->Play(GetMesh()->GetAnimInstance()) : 0.f;
 }
 
 
 float APlayerCharacter::PlayDeathMontage()
 {
 	// play appropriate death anim + update death pose to match
-	int32 Selection;
+	float AnimDuration;
 
 	// validate death anim space
 	bool ClearFront = IsClearFront();
@@ -1084,25 +1092,22 @@ float APlayerCharacter::PlayDeathMontage()
 
 	if (!ClearFront && ClearBehind)
 	{
-		Selection = PlayRandomMontageSection(DeathMontage, DeathMontageBackwardOnlySections);
+		AnimDuration = PlayRandomMontageSection(DeathBackwardSections);
 		PlayerDeathPose = EPlayerDeathPose::EPD_BackwardPose1;
 	}
 
 	else if (!ClearBehind && ClearFront)
 	{
-		Selection = PlayRandomMontageSection(DeathMontage, DeathMontageForwardOnlySections);
+		AnimDuration = PlayRandomMontageSection(DeathForwardSections);
 		PlayerDeathPose = EPlayerDeathPose::EPD_ForwardPose1;
 	}
 
 	else // either both blocked or both clear
 	{
-		Selection = PlayRandomMontageSection(DeathMontage, DeathMontageBackwardOnlySections);
+		AnimDuration = PlayRandomMontageSection(DeathBackwardSections);
 		PlayerDeathPose = EPlayerDeathPose::EPD_BackwardPose1; // favor backwards pose
 	}
 
-	FString SelectStr = FString::FromInt(Selection);
-
-	float AnimDuration = DeathMontage->GetSectionLength(Selection);
 	return AnimDuration;
 }
 
@@ -1181,37 +1186,8 @@ EHitDirection APlayerCharacter::GetHitDirection()
 }
 
 
-FPlayerHitReact APlayerCharacter::GetPlayerHitReactToPlay()
+const FMontageSection& APlayerCharacter::GetPlayerHitReactToPlay()
 {
-	EHitDirection HitDirection = GetHitDirection();
-
-	// determine which montage and section to play
-	UAnimMontage* MontageToPlay = HitReactsMontage;
-	FName SectionToPlay;
-
-	switch (HitDirection)
-	{
-	case EHitDirection::EHD_Front:
-		SectionToPlay = FName("FromFront");
-		break;
-	case EHitDirection::EHD_Back:
-		SectionToPlay = FName("FromBack");
-		break;
-	case EHitDirection::EHD_Left:
-		SectionToPlay = FName("FromLeft");
-		break;
-	case EHitDirection::EHD_Right:
-		SectionToPlay = FName("FromRight");
-		break;
-
-	default:
-		SectionToPlay = FName("FromFront");
-		break;
-	}
-
-	FPlayerHitReact HitReactData;
-	HitReactData.MontageToPlay = MontageToPlay;
-	HitReactData.SectionToPlay = SectionToPlay;
-
-	return HitReactData;
+	// directional section, resolved on BeginPlay
+	return HitReactSections.Get((int32)GetHitDirection());
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "../Items/EquippableItem.h"
+#include "../Framework/AppearanceBuilderSubsystem.h"
+#include "../Animation/MontageSectionTable.h"
 #include "PlayerCharacter.generated.h"
 
 
@@ -44,15 +46,6 @@ enum class EHitDirection : uint8
 	EHD_MAX		UMETA(DisplayName = "DefaultMAX")
 };
 
-USTRUCT(BlueprintType)
-struct FPlayerHitReact
-{
-	GENERATED_BODY()
-
-	UAnimMontage* MontageToPlay;
-	FName SectionToPlay;
-};
-
 // interaction data struct
 USTRUCT()
 struct FInteractionData
@@ -140,6 +133,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mesh Components")
 	class USkeletalMeshComponent* BeltPouchMesh;
 
+	// merge the body-fitted modular meshes (chest, hands, legs, feet) into one skinned mesh; socket-attached meshes (hair, etc.) stay separate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mesh Components")
+	bool bMergeModularMeshes;
+
+	// call again after changing any of the merged parts' meshes
+	UFUNCTION(BlueprintCallable, Category = "Mesh Components")
+	void RebuildAppearance();
+
 	/**
 	*   camera defaults
 	*/
@@ -394,6 +395,11 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	UAnimMontage* HitReactsMontage;
 
+	// death + hit react sections, resolved on BeginPlay
+	FMontageSectionList DeathBackwardSections;
+	FMontageSectionList DeathForwardSections;
+	FDirectionalMontageSections HitReactSections;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	USoundBase* RandomHurtCue;
 
@@ -409,6 +415,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Inventory")
 	TMap<EEquippableSlot, UEquippableItem*> EquippedItems;
 
+	UPROPERTY(Transient)
+	FModularAppearance MergedAppearance;
+
 public:	
 
 	// called every frame
@@ -598,9 +607,8 @@ public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void UpdateBloodScreenBP();
 
-	void PlayMontageSection(UAnimMontage* Montage, const FName& SectionName);
-
-	int32 PlayRandomMontageSection(UAnimMontage* Montage, const TArray<FName>& SectionNames);
+	// plays a random section from the list; returns its length
+	float PlayRandomMontageSection(const FMontageSectionList& SectionList);
 
 	float PlayDeathMontage();
 
@@ -613,7 +621,7 @@ public:
 
 	EHitDirection GetHitDirection();
 
-	FPlayerHitReact GetPlayerHitReactToPlay();
+	const FMontageSection& GetPlayerHitReactToPlay();
 
 	UFUNCTION(BlueprintImplementableEvent)
 	void StopReloadAudioBP();
@@ -2,8 +2,14 @@
 
 
 #include "../Weapons/Weapon.h"
+#include "../Weapons/WeaponArchetype.h"
 #include "../DebugMacros.h"
 #include "../Components/InventoryComponent.h"
+#include "../Effects/DecalPoolSubsystem.h"
+#include "../Effects/FXPoolSubsystem.h"
+#include "../Effects/AudioVoiceSubsystem.h"
+#include "../Framework/HitZoneSubsystem.h"
+#include "../Framework/LegacyDataMigration.h"
 #include "../Enemies/Enemy.h"
 #include "../Items/EquippableItem.h"
 #include "../Items/AmmoItem.h"
@@ -15,6 +21,7 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Curves/CurveVector.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/AssetManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
@@ -31,9 +38,6 @@ AWeapon::AWeapon()
 	WeaponMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
 	RootComponent = WeaponMesh;
 
-	bLoopedFireAnim = false;
-	bLoopedFireSound = false;
-	bLoopedMuzzleFX = false;
 	bPlayingFireAnim = false;
 	bIsEquipped = false;
 	bWantsToFire = false;
@@ -42,21 +46,31 @@ AWeapon::AWeapon()
 	bHasBeenFired = false;
 	bHavePlayedOutOfAmmoSound = false;
 	CurrentState = EWeaponState::Idle;
-	AttachSocket = FName("Pistol_Socket");
 
 	CurrentAmmoInClip = 0;
 	BurstCounter = 0;
 	LastFireTime = 0.0f;
 
+	Archetype = nullptr;
+	bArchetypeAssetsLoaded = false;
+	DamageMapId = INDEX_NONE;
+
+#if WITH_EDITORONLY_DATA
+	// legacy config defaults, unchanged: older blueprints only saved where they differed from these
+	AttachSocket = FName("Pistol_Socket");
 	ADSTime = 0.5f;
 	RecoilResetSpeed = 5.f;
 	RecoilSpeed = 10.f;
-
 	BulletCasingSoundDelay = 1.f;
 	BulletCasingVolumeMultiplier = .75f;
 	BulletHoleSize = FVector(3.f, 3.f, 3.f);
 	BloodBulletHoleSize = FVector(1.5f, 1.5f, 1.5f);
 	BulletHoleLifespan = 300.f;
+	bLoopedFireAnim = false;
+	bLoopedFireSound = false;
+	bLoopedMuzzleFX = false;
+	LegacyArchetype = nullptr;
+#endif
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
@@ -66,9 +80,129 @@ AWeapon::AWeapon()
 // called when the game starts or when spawned
 void AWeapon::BeginPlay()
 {
+	// shared type data first, so BP BeginPlay sees a ready weapon
+	ApplyArchetype();
+
 	Super::BeginPlay();
 	
 	PawnOwner = Cast<APlayerCharacter>(GetOwner());
+
+	PrewarmPooledFX();
+}
+
+
+// have components ready before the first shot
+void AWeapon::PrewarmPooledFX()
+{
+	if (UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>())
+	{
+		FXPool->PrewarmSystem(GetArchetype().BulletEjectionFX.Get());
+		FXPool->PrewarmSystem(GetArchetype().ImpactParticles.Get());
+	}
+}
+
+
+const FWeaponData& AWeapon::GetWeaponData() const
+{
+	return GetArchetype().WeaponConfig;
+}
+
+
+const FHitScanConfiguration& AWeapon::GetHitScanConfig() const
+{
+	return GetArchetype().HitScanConfig;
+}
+
+
+int32 AWeapon::GetAmmoPerClip() const
+{
+	return GetWeaponData().AmmoPerClip;
+}
+
+
+const UWeaponArchetype& AWeapon::GetArchetype() const
+{
+	if (Archetype) { return *Archetype; }
+
+#if WITH_EDITORONLY_DATA
+	// not migrated yet (see MigrateToArchetype); keep playing as authored
+	if (LegacyArchetype == nullptr) { LegacyArchetype = FLegacyDataMigration::MakeTransientAsset<UWeaponArchetype>(*this); }
+	return *LegacyArchetype;
+#else
+	return *GetDefault<UWeaponArchetype>();
+#endif
+}
+
+
+void AWeapon::ApplyArchetype()
+{
+	// caught by data validation (see IsDataValid); the fallback only keeps a broken weapon from crashing
+	ensureMsgf(Archetype, TEXT("%s has no weapon archetype; using fallback values"), *GetName());
+
+	// damage tables ready before the first hit (weapons sharing a modifier map share them)
+	if (UHitZoneSubsystem* HitZones = GetWorld()->GetSubsystem<UHitZoneSubsystem>())
+	{ DamageMapId = HitZones->RegisterDamageMap(GetHitScanConfig().BoneDamageModifiers); }
+}
+
+
+#if WITH_EDITOR
+void AWeapon::MigrateToArchetype()
+{
+	if (Archetype) { return; }
+
+	UWeaponArchetype* NewArchetype = FLegacyDataMigration::CreateAsset<UWeaponArchetype>(*this, TEXT("_Archetype"));
+	if (NewArchetype == nullptr) { return; }
+
+	Modify();
+	Archetype = NewArchetype;
+	LegacyArchetype = nullptr;
+	MarkPackageDirty();
+}
+
+
+EDataValidationResult AWeapon::IsDataValid(FDataValidationContext& Context) const
+{
+	return CombineDataValidationResults(Super::IsDataValid(Context), FLegacyDataMigration::ValidateAssigned(*this, Archetype, TEXT("weapon archetype"), Context));
+}
+#endif
+
+
+// stream in the archetype's soft references, then finish equipping (see OnEquip)
+void AWeapon::LoadArchetypeAssets()
+{
+	if (ArchetypeAssetsHandle.IsValid()) { return; }
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	GetArchetype().GetAssetsToLoad(AssetsToLoad);
+
+	ArchetypeAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateUObject(this, &AWeapon::OnArchetypeAssetsLoaded));
+
+	// nothing to load, or all already resident
+	if (!ArchetypeAssetsHandle.IsValid() || ArchetypeAssetsHandle->HasLoadCompleted())
+	{ OnArchetypeAssetsLoaded(); }
+}
+
+
+void AWeapon::OnArchetypeAssetsLoaded()
+{
+	if (bArchetypeAssetsLoaded) { return; }
+
+	bArchetypeAssetsLoaded = true;
+	PrewarmPooledFX();
+
+	// resume equipping (unless unequipped while loading)
+	if (bPendingEquip)
+	{ OnEquip(); }
+}
+
+
+void AWeapon::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// async shots fired last frame (TG_PrePhysics, so this is the start of the frame)
+	if (PendingShots.Num() > 0)
+	{ ResolvePendingShots(); }
 }
 
 
@@ -87,6 +221,12 @@ void AWeapon::Destroyed()
 	Super::Destroyed();
 
 	StopSimulatingWeaponFire();
+
+	if (ArchetypeAssetsHandle.IsValid())
+	{
+		ArchetypeAssetsHandle->CancelHandle();
+		ArchetypeAssetsHandle.Reset();
+	}
 }
 
 
@@ -103,7 +243,7 @@ void AWeapon::ConsumeAmmo(const int32 Amount)
 	{
 		if (UInventoryComponent* Inventory = PawnOwner->PlayerInventory)
 		{
-			if (UItem* AmmoItem = Inventory->FindItemByClass(WeaponConfig.AmmoClass))
+			if (UItem* AmmoItem = Inventory->FindItemByClass(GetWeaponData().AmmoClass))
 			{ Inventory->ConsumeItem(AmmoItem, Amount); }
 		}
 	}
@@ -116,7 +256,8 @@ void AWeapon::ReturnAmmoToInventory()
 	{
 		if (UInventoryComponent* Inventory = PawnOwner->PlayerInventory)
 		{
-			Inventory->TryAddItemFromClass(WeaponConfig.AmmoClass, CurrentAmmoInClip);
+			FInventoryChangeBatchScope ChangeBatch(Inventory);
+			Inventory->TryAddItemFromClass(GetWeaponData().AmmoClass, CurrentAmmoInClip);
 			CurrentAmmoInClip = 0;
 		}
 	}
@@ -126,6 +267,14 @@ void AWeapon::ReturnAmmoToInventory()
 // attach mesh, set flags, update state + play anim and call OnEquipFinished() when done
 void AWeapon::OnEquip()
 {
+	// archetype assets stream in on first equip; equipping resumes once they're resident
+	if (!bArchetypeAssetsLoaded)
+	{
+		bPendingEquip = true;
+		LoadArchetypeAssets();
+		return;
+	}
+
 	// attach weapon to Holster_Socket and ensure holster/etc visible on player
 	AttachMeshToPawn();
 	PawnOwner->HolsterMesh->SetHiddenInGame(false);
@@ -136,7 +285,7 @@ void AWeapon::OnEquip()
 
 	if (PawnOwner)
 	{	
-		if (EquipAnim)
+		if (UAnimMontage* EquipAnim = GetArchetype().EquipAnim.Get())
 		{
 			float AnimDuration = PlayPlayerWeaponAnimation(EquipAnim, 1.f);
 			if (AnimDuration <= 0.0f) { AnimDuration = .5f; }
@@ -147,7 +296,7 @@ void AWeapon::OnEquip()
 		else { OnEquipFinished(); }
 
 
-		WeaponMesh->AttachToComponent(PawnOwner->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, AttachSocket);
+		WeaponMesh->AttachToComponent(PawnOwner->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, GetArchetype().AttachSocket);
 		PawnOwner->HolsteredPistolMesh->SetHiddenInGame(true);
 		OnEquipFinished();
 
@@ -187,8 +336,8 @@ void AWeapon::OnUnequip()
 
 	if (bPendingReload)
 	{
-		StopPlayerWeaponAnimation(LoweredReloadAnim);
-		StopPlayerWeaponAnimation(AimingReloadAnim);
+		StopPlayerWeaponAnimation(GetArchetype().LoweredReloadAnim.Get());
+		StopPlayerWeaponAnimation(GetArchetype().AimingReloadAnim.Get());
 		bPendingReload = false;
 
 		GetWorldTimerManager().ClearTimer(TimerHandle_StopReload);
@@ -197,13 +346,13 @@ void AWeapon::OnUnequip()
 
 	if (bPendingEquip)
 	{
-		StopPlayerWeaponAnimation(EquipAnim);
+		StopPlayerWeaponAnimation(GetArchetype().EquipAnim.Get());
 		bPendingEquip = false;
 
 		GetWorldTimerManager().ClearTimer(TimerHandle_OnEquipFinished);
 	}
 
-	if (UnequipAnim)
+	if (UAnimMontage* UnequipAnim = GetArchetype().UnequipAnim.Get())
 	{
 		float AnimDuration = .5f;
 
@@ -282,7 +431,7 @@ void AWeapon::StartReload()
 		// update HUD widget
 		PawnOwner->ShowAmmoCounter();
 
-		UAnimMontage* AnimToPlay = PawnOwner->IsAiming() ? AimingReloadAnim : LoweredReloadAnim;
+		UAnimMontage* AnimToPlay = PawnOwner->IsAiming() ? GetArchetype().AimingReloadAnim.Get() : GetArchetype().LoweredReloadAnim.Get();
 		float AnimDuration = PlayPlayerWeaponAnimation(AnimToPlay, 0.85f);
 		if (AnimDuration <= 0.0f) { AnimDuration = .5f; }
 
@@ -299,8 +448,8 @@ void AWeapon::StopReload()
 	{
 		bPendingReload = false;
 		DetermineWeaponState();
-		StopPlayerWeaponAnimation(LoweredReloadAnim);
-		StopPlayerWeaponAnimation(AimingReloadAnim);
+		StopPlayerWeaponAnimation(GetArchetype().LoweredReloadAnim.Get());
+		StopPlayerWeaponAnimation(GetArchetype().AimingReloadAnim.Get());
 		PawnOwner->StopReloadAudioBP();
 	}
 }
@@ -309,7 +458,7 @@ void AWeapon::StopReload()
 void AWeapon::ReloadWeapon()
 {
 	// how much space is remaining in magazine
-	int32 ClipDelta = FMath::Min(WeaponConfig.AmmoPerClip - CurrentAmmoInClip, GetCurrentAmmoInInventory());
+	int32 ClipDelta = FMath::Min(GetWeaponData().AmmoPerClip - CurrentAmmoInClip, GetCurrentAmmoInInventory());
 
 	// fill remainder from inventory ammo supply
 	if (ClipDelta > 0)
@@ -344,7 +493,7 @@ bool AWeapon::CanFire() const
 bool AWeapon::CanReload() const
 {
 	bool bCanReload = PawnOwner != nullptr && IsEquipped() && PawnOwner->bAlive;
-	bool bHaveAmmo = (CurrentAmmoInClip < WeaponConfig.AmmoPerClip) && (GetCurrentAmmoInInventory() > 0);
+	bool bHaveAmmo = (CurrentAmmoInClip < GetWeaponData().AmmoPerClip) && (GetCurrentAmmoInInventory() > 0);
 	bool bStateOKToReload = ((CurrentState == EWeaponState::Idle) || (CurrentState == EWeaponState::Empty) || (CurrentState == EWeaponState::Firing));
 
 	return ((bCanReload == true) && (bHaveAmmo == true) && (bStateOKToReload == true));
@@ -358,7 +507,7 @@ int32 AWeapon::GetCurrentAmmoInInventory() const
 	{
 		if (UInventoryComponent* Inventory = PawnOwner->PlayerInventory)
 		{
-			if (UItem* Ammo = Inventory->FindItemByClass(WeaponConfig.AmmoClass))
+			if (UItem* Ammo = Inventory->FindItemByClass(GetWeaponData().AmmoClass))
 			{ return Ammo->GetQuantity(); }
 		}
 	}
@@ -378,53 +527,54 @@ void AWeapon::SimulateWeaponFire()
 	if (CurrentState != EWeaponState::Firing) { return; }
 
 	// spawn particle FX
-	if (MuzzleFX)
+	if (UParticleSystem* MuzzleFX = GetArchetype().MuzzleFX.Get())
 	{
-		if (!bLoopedMuzzleFX || MuzzlePSC == NULL)
+		if (!GetArchetype().bLoopedMuzzleFX || MuzzlePSC == NULL)
 		{
 			if (APlayerCharacterController* PC = Cast<APlayerCharacterController>(PawnOwner->GetController()))
-			{ MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, WeaponMesh, MuzzleAttachPoint); }
+			{ MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, WeaponMesh, GetArchetype().MuzzleAttachPoint); }
 		}
 	}
 
-	if (BulletEjectionFX)
+	if (UNiagaraSystem* BulletEjectionFX = GetArchetype().BulletEjectionFX.Get())
 	{
 		//UNiagaraComponent* BulletEjectComp = UNiagaraFunctionLibrary::SpawnSystemAttached(BulletEjectionFX, WeaponMesh, MuzzleAttachPoint, FVector(0.f), FRotator(0.f), EAttachLocation::KeepRelativeOffset, true);
-		FVector EjectLoc = WeaponMesh->GetSocketLocation(MuzzleAttachPoint);
-		UNiagaraComponent* BulletEjectComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), BulletEjectionFX, EjectLoc);
+		FVector EjectLoc = WeaponMesh->GetSocketLocation(GetArchetype().MuzzleAttachPoint);
+		if (UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>())
+		{ FXPool->SpawnSystemAtLocation(BulletEjectionFX, EjectLoc); }
 
-		if (BulletCasingLandingSound)
-		{ GetWorldTimerManager().SetTimer(TimerHandle_BulletCasingLandingSound, this, &AWeapon::PlayBulletCasingLandingSound, BulletCasingSoundDelay); }
+		if (GetArchetype().BulletCasingLandingSound.Get())
+		{ GetWorldTimerManager().SetTimer(TimerHandle_BulletCasingLandingSound, this, &AWeapon::PlayBulletCasingLandingSound, GetArchetype().BulletCasingSoundDelay); }
 	}
 
 	// play firing anim
-	if (!bLoopedFireAnim || !bPlayingFireAnim)
+	if (!GetArchetype().bLoopedFireAnim || !bPlayingFireAnim)
 	{
-		PlayPlayerWeaponAnimation(FireAnim, 1.f);
-		WeaponMesh->PlayAnimation(WeaponFireAnim, false);
+		PlayPlayerWeaponAnimation(GetArchetype().FireAnim.Get(), 1.f);
+		WeaponMesh->PlayAnimation(GetArchetype().WeaponFireAnim.Get(), false);
 		bPlayingFireAnim = true;
 	}
 
 	// play firing sound
-	if (bLoopedFireSound)
+	if (GetArchetype().bLoopedFireSound)
 	{
-		if (FireAC == NULL)
-		{ FireAC = PlayWeaponSound(FireLoopSound); }
+		if (!FireVoice.IsSet())
+		{ FireVoice = PlayWeaponSound(GetArchetype().FireLoopSound.Get()); }
 	}
 
 	else
-	{ PlayWeaponSound(FireSound); }
+	{ PlayWeaponSound(GetArchetype().FireSound.Get()); }
 
 	// apply recoil / play controller vibration
 	if (APlayerCharacterController* PC = Cast<APlayerCharacterController>(PawnOwner->GetController()))
 	{
-		if (RecoilCurve)
+		if (const UCurveVector* RecoilCurve = GetArchetype().RecoilCurve.Get())
 		{
 			const FVector2D RecoilAmount(RecoilCurve->GetVectorValue(FMath::RandRange(0.f, 1.f)).X, RecoilCurve->GetVectorValue(FMath::RandRange(0.f, 1.f)).Y);
-			PawnOwner->ApplyRecoil(RecoilAmount, RecoilSpeed, RecoilResetSpeed);
+			PawnOwner->ApplyRecoil(RecoilAmount, GetArchetype().RecoilSpeed, GetArchetype().RecoilResetSpeed);
 		}
 
-		if (FireForceFeedback)
+		if (UForceFeedbackEffect* FireForceFeedback = GetArchetype().FireForceFeedback.Get())
 		{
 			FForceFeedbackParameters FFParams;
 			FFParams.Tag = "Weapon";
@@ -438,7 +588,7 @@ void AWeapon::SimulateWeaponFire()
 void AWeapon::StopSimulatingWeaponFire()
 {
 	// stop muzzle particle FX
-	if (bLoopedMuzzleFX)
+	if (GetArchetype().bLoopedMuzzleFX)
 	{
 		if (MuzzlePSC)
 		{
@@ -448,61 +598,272 @@ void AWeapon::StopSimulatingWeaponFire()
 	}
 
 	// stop firing anim
-	if (bLoopedFireAnim && bPlayingFireAnim)
+	if (GetArchetype().bLoopedFireAnim && bPlayingFireAnim)
 	{
-		StopPlayerWeaponAnimation(FireAnim);
+		StopPlayerWeaponAnimation(GetArchetype().FireAnim.Get());
 		bPlayingFireAnim = false;
 	}
 
 	// stop sound FX
-	if (FireAC)
+	if (FireVoice.IsSet())
 	{
-		FireAC->FadeOut(0.1f, 0.0f);
-		FireAC = NULL;
+		UAudioVoiceSubsystem* VoicePool = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+		if (UAudioComponent* FireAC = VoicePool ? VoicePool->GetVoiceComponent(FireVoice) : nullptr)
+		{ FireAC->FadeOut(0.1f, 0.0f); }
+		FireVoice.Reset();
 
-		PlayWeaponSound(FireFinishSound);
+		PlayWeaponSound(GetArchetype().FireFinishSound.Get());
 	}
 }
 
 
-// process the hit
-void AWeapon::HandleHit(const FHitResult& Hit, class AEnemy* HitEnemy /*= nullptr*/)
+// bone-specific damage modifier for a hit (1 if none)
+float AWeapon::GetBoneDamageMultiplier(const FHitResult& Hit)
 {
-	if (PawnOwner)
+	// skeletal hit: one lookup by bone index in the table compiled for the hit mesh (unmapped bones inherit their parent's modifier)
+	const USkeletalMeshComponent* HitMeshComp = Cast<USkeletalMeshComponent>(Hit.GetComponent());
+	const USkeletalMesh* HitMesh = HitMeshComp ? HitMeshComp->GetSkeletalMeshAsset() : nullptr;
+	if (HitMesh && (!DamageZones.IsValid() || DamageZones->Mesh != TObjectKey<USkeletalMesh>(HitMesh)))
+	{
+		if (UHitZoneSubsystem* HitZones = GetWorld()->GetSubsystem<UHitZoneSubsystem>())
+		{
+			DamageZones = HitZones->GetDamageTable(HitMesh, DamageMapId);
+		}
+	}
+
+	if (HitMesh && DamageZones.IsValid())
+	{ return DamageZones->Get(UHitZoneSubsystem::GetHitBoneIndex(Hit)); }
+
+	// anything else: by name
+	if (const float* Multiplier = GetHitScanConfig().BoneDamageModifiers.Find(Hit.BoneName))
+	{ return *Multiplier; }
+
+	return 1.f;
+}
+
+
+// apply a shot's (pellet-aggregated) damage to an enemy; Hit is the pellet hit used for hit reacts
+void AWeapon::HandleHit(const FHitResult& Hit, class AEnemy* HitEnemy, float Damage)
+{
+	if (PawnOwner && HitEnemy)
 	{
-		float DamageMultiplier = 1.f;
+		// store which bone was hit and the direction hit came from
+		HitEnemy->LastHitResult = Hit;
+		HitEnemy->LastBoneHit = Hit.BoneName;
+		HitEnemy->LastHitImpactPoint = Hit.ImpactPoint;
+		HitEnemy->LastHitPlayerLocation = PawnOwner->GetActorLocation();
+
+		UGameplayStatics::ApplyPointDamage(HitEnemy, Damage, (Hit.TraceStart - Hit.TraceEnd).GetSafeNormal(), Hit, PawnOwner->GetController(), PawnOwner, GetHitScanConfig().DamageType);
 
-		// apply any bone-specific damage modifiers
-		for (auto& BoneDamageModifier : HitScanConfig.BoneDamageModifiers)
+		// spawn blood splash impact particle FX
+		HitEnemy->PlayBloodHitFX(Hit);
+	}
+}
+
+
+// pooled bullet hole decal with a random roll
+void AWeapon::SpawnBulletHoleDecal(UMaterialInstance* DecalMaterial, const FVector& DecalSize, const FHitResult& Hit)
+{
+	if (UDecalPoolSubsystem* DecalPool = GetWorld()->GetSubsystem<UDecalPoolSubsystem>())
+	{
+		FRotator RandomDecalRotation = Hit.ImpactNormal.Rotation();
+		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
+		DecalPool->SpawnDecalAtHit(DecalMaterial, DecalSize, Hit, RandomDecalRotation, GetArchetype().BulletHoleLifespan);
+	}
+}
+
+
+// world position + direction of the crosshairs
+bool AWeapon::GetShotAim(FVector& OutOrigin, FVector& OutDirection) const
+{
+	FVector2D ViewportSize;
+	if (GEngine && GEngine->GameViewport)
+	{
+		// get current viewport size, store in ViewportSize
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
+	}
+
+	// get screen space location of crosshairs
+	FVector2D CrosshairLocation(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
+	CrosshairLocation.Y -= 150.f; // adjust up by 150 units (also done in BP_HUD)
+
+	return UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), CrosshairLocation, OutOrigin, OutDirection);
+}
+
+
+// one trace end per pellet, spread in a cone around the aim direction
+void AWeapon::BuildPelletTraceEnds(const FVector& Origin, const FVector& Direction, TArray<FVector>& OutTraceEnds) const
+{
+	const int32 PelletCount = FMath::Max(1, GetHitScanConfig().PelletCount);
+	const float SpreadRadians = FMath::DegreesToRadians(GetHitScanConfig().PelletSpread);
+
+	OutTraceEnds.Reset(PelletCount);
+	for (int32 Pellet = 0; Pellet < PelletCount; ++Pellet)
+	{
+		const FVector PelletDirection = SpreadRadians > 0.f ? FMath::VRandCone(Direction, SpreadRadians) : Direction;
+		OutTraceEnds.Add(Origin + (PelletDirection * GetHitScanConfig().Distance));
+	}
+}
+
+
+FCollisionQueryParams AWeapon::GetShotQueryParams() const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponHitscan));
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(PawnOwner);
+	QueryParams.bReturnPhysicalMaterial = true;
+	QueryParams.bTraceComplex = true;
+
+	return QueryParams;
+}
+
+
+// resolve every pellet of a shot in one pass (line or sphere trace, per GetHitScanConfig().Radius)
+void AWeapon::TracePellets(const FVector& Origin, const TArray<FVector>& TraceEnds, TArray<FHitResult>& OutHits) const
+{
+	const FCollisionQueryParams QueryParams = GetShotQueryParams();
+
+	const FCollisionShape TraceShape = GetHitScanConfig().Radius > 0.f ? FCollisionShape::MakeSphere(GetHitScanConfig().Radius) : FCollisionShape();
+
+	OutHits.SetNum(TraceEnds.Num());
+	for (int32 Pellet = 0; Pellet < TraceEnds.Num(); ++Pellet)
+	{
+		if (TraceShape.IsNearlyZero())
+		{ GetWorld()->LineTraceSingleByChannel(OutHits[Pellet], Origin, TraceEnds[Pellet], ECollisionChannel::ECC_Visibility, QueryParams); }
+		else
+		{ GetWorld()->SweepSingleByChannel(OutHits[Pellet], Origin, TraceEnds[Pellet], FQuat::Identity, ECollisionChannel::ECC_Visibility, TraceShape, QueryParams); }
+		//DrawDebugLine(GetWorld(), Origin, TraceEnds[Pellet], FColor::Green, false, 2.f);
+	}
+}
+
+
+void AWeapon::TracePelletsAsync(const FVector& Origin, const TArray<FVector>& TraceEnds)
+{
+	const FCollisionQueryParams QueryParams = GetShotQueryParams();
+	const FCollisionShape TraceShape = GetHitScanConfig().Radius > 0.f ? FCollisionShape::MakeSphere(GetHitScanConfig().Radius) : FCollisionShape();
+
+	FPendingShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Origin = Origin;
+	Shot.FrameIssued = GFrameCounter;
+	Shot.TraceEnds = TraceEnds;
+	Shot.TraceHandles.Reserve(TraceEnds.Num());
+
+	for (const FVector& TraceEnd : TraceEnds)
+	{
+		if (TraceShape.IsNearlyZero())
+		{ Shot.TraceHandles.Add(GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Origin, TraceEnd, ECollisionChannel::ECC_Visibility, QueryParams)); }
+		else
+		{ Shot.TraceHandles.Add(GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, Origin, TraceEnd, FQuat::Identity, ECollisionChannel::ECC_Visibility, TraceShape, QueryParams)); }
+	}
+}
+
+
+// collect last frame's async pellet traces and resolve each shot in order
+void AWeapon::ResolvePendingShots()
+{
+	TArray<FHitResult> PelletHits;
+	int32 NumResolved = 0;
+
+	for (; NumResolved < PendingShots.Num(); ++NumResolved)
+	{
+		const FPendingShot& Shot = PendingShots[NumResolved];
+
+		// fired earlier this frame (e.g., from input); its traces haven't run yet
+		if (Shot.FrameIssued == GFrameCounter) { break; }
+
+		PelletHits.Reset();
+		PelletHits.SetNum(Shot.TraceHandles.Num());
+
+		bool bAllResolved = true;
+		for (int32 Pellet = 0; Pellet < Shot.TraceHandles.Num(); ++Pellet)
 		{
-			if (Hit.BoneName == BoneDamageModifier.Key)
+			FTraceDatum TraceDatum;
+			if (!GetWorld()->QueryTraceData(Shot.TraceHandles[Pellet], TraceDatum))
 			{
-				DamageMultiplier = BoneDamageModifier.Value;
+				bAllResolved = false;
 				break;
 			}
+
+			if (TraceDatum.OutHits.Num() > 0)
+			{ PelletHits[Pellet] = TraceDatum.OutHits[0]; }
 		}
 
-		// apply damage to enemy
-		if (HitEnemy)
+		// result no longer available (e.g., a hitch skipped the frame); trace this shot synchronously instead
+		if (!bAllResolved)
+		{ TracePellets(Shot.Origin, Shot.TraceEnds, PelletHits); }
+
+		ResolveShotHits(PelletHits);
+	}
+
+	PendingShots.RemoveAt(0, NumResolved, false);
+}
+
+
+// apply a shot's pellet hits: world impacts per pellet; enemy damage summed per enemy, then applied once each
+void AWeapon::ResolveShotHits(const TArray<FHitResult>& PelletHits)
+{
+	if (PawnOwner == nullptr) { return; }
+
+	// every pellet that hit a given enemy, folded into one damage event
+	struct FEnemyShotDamage
+	{
+		AEnemy* Enemy;
+		float Damage;
+		int32 PrimaryHitIndex;
+		float PrimaryMultiplier;
+	};
+	TArray<FEnemyShotDamage, TInlineAllocator<8>> EnemyDamage;
+
+	bool bReportedImpact = false;
+
+	for (int32 Pellet = 0; Pellet < PelletHits.Num(); ++Pellet)
+	{
+		const FHitResult& Hit = PelletHits[Pellet];
+		if (!Hit.bBlockingHit) { continue; }
+
+		// one impact noise per shot
+		if (!bReportedImpact)
 		{
-			// store which bone was hit and the direction hit came from
-			HitEnemy->LastHitResult = Hit;
-			HitEnemy->LastBoneHit = Hit.BoneName;
-			HitEnemy->LastHitImpactPoint = Hit.ImpactPoint;
-			HitEnemy->LastHitPlayerLocation = PawnOwner->GetActorLocation();
-	
-			UGameplayStatics::ApplyPointDamage(HitEnemy, HitScanConfig.Damage * DamageMultiplier, (Hit.TraceStart - Hit.TraceEnd).GetSafeNormal(), Hit, PawnOwner->GetController(), PawnOwner, HitScanConfig.DamageType);
-		
-			// spawn blood splash impact particle FX
-			HitEnemy->PlayBloodHitFX(Hit);
-
-			// spawn bullet hole decal
-			FRotator RandomDecalRotation = Hit.ImpactNormal.Rotation();
-			RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
-			UDecalComponent* BloodBulletHoleDecalComp = UGameplayStatics::SpawnDecalAttached(BloodBulletHoleDecal, BloodBulletHoleSize, Hit.GetComponent(), Hit.BoneName, Hit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition);
-			BloodBulletHoleDecalComp->SetFadeScreenSize(0.f);
+			PawnOwner->ReportAINoiseEventBP(1.f, Hit.Location, FName("BulletImpact"));
+			bReportedImpact = true;
+		}
+
+		if (AEnemy* HitEnemy = Cast<AEnemy>(Hit.GetActor()))
+		{
+			const float Multiplier = GetBoneDamageMultiplier(Hit);
+
+			FEnemyShotDamage* Entry = EnemyDamage.FindByPredicate([HitEnemy](const FEnemyShotDamage& Existing) { return Existing.Enemy == HitEnemy; });
+			if (Entry == nullptr)
+			{ EnemyDamage.Add({ HitEnemy, GetHitScanConfig().Damage * Multiplier, Pellet, Multiplier }); }
+			else
+			{
+				Entry->Damage += GetHitScanConfig().Damage * Multiplier;
+
+				// the most damaging pellet drives the hit react (e.g., a headshot)
+				if (Multiplier > Entry->PrimaryMultiplier)
+				{
+					Entry->PrimaryHitIndex = Pellet;
+					Entry->PrimaryMultiplier = Multiplier;
+				}
+			}
+
+			SpawnBulletHoleDecal(GetArchetype().BloodBulletHoleDecal.Get(), GetArchetype().BloodBulletHoleSize, Hit);
+		}
+
+		// don't call impact particle FX if hit enemy (different FX, handled on enemy's damage application)
+		else if (GetArchetype().ImpactParticles.Get() && GetArchetype().BulletHoleDecal.Get())
+		{
+			// spawn impact particle FX
+			if (UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>())
+			{ FXPool->SpawnSystemAtLocation(GetArchetype().ImpactParticles.Get(), Hit.Location); }
+
+			SpawnBulletHoleDecal(GetArchetype().BulletHoleDecal.Get(), GetArchetype().BulletHoleSize, Hit);
 		}
 	}
+
+	// one TakeDamage (and so one hit react) per enemy per shot
+	for (const FEnemyShotDamage& Entry : EnemyDamage)
+	{ HandleHit(PelletHits[Entry.PrimaryHitIndex], Entry.Enemy, Entry.Damage); }
 }
 
 
@@ -513,73 +874,23 @@ void AWeapon::FireShot()
 	{
 		//PawnOwner->MakeNoise(1.f, PawnOwner, GetActorLocation());
 		PawnOwner->ReportAINoiseEventBP(1.f, GetActorLocation(), FName("WeaponFiring"));
-		
-		const FTransform MuzzleTransform = WeaponMesh->GetSocketTransform(MuzzleAttachPoint);
 
-		FVector2D ViewportSize;
-		if (GEngine && GEngine->GameViewport)
+		// trace outwards from crosshairs world location, one trace per pellet
+		FVector AimOrigin;
+		FVector AimDirection;
+		if (GetShotAim(AimOrigin, AimDirection))
 		{
-			// get current viewport size, store in ViewportSize
-			GEngine->GameViewport->GetViewportSize(ViewportSize);
-		}
-
-		// get screen space location of crosshairs
-		FVector2D CrosshairLocation(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
-		CrosshairLocation.Y -= 150.f; // adjust up by 150 units (also done in BP_HUD)
-
-		// get world position + direction of crosshairs
-		FVector CrosshairWorldPosition;
-		FVector CrosshairWorldDirection;
+			TArray<FVector> TraceEnds;
+			BuildPelletTraceEnds(AimOrigin, AimDirection, TraceEnds);
 
-		bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), 
-		CrosshairLocation,CrosshairWorldPosition, CrosshairWorldDirection);
-
-		// if deprojection was successful, perform line trace
-		if (bScreenToWorld)
-		{
-			// setup line trace
-			FHitResult ScreenTraceHit;
-			const FVector TraceStart = CrosshairWorldPosition;
-			const FVector TraceEnd = CrosshairWorldPosition + (CrosshairWorldDirection * HitScanConfig.Distance);
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(this);
-			QueryParams.AddIgnoredActor(PawnOwner);
-			QueryParams.bReturnPhysicalMaterial = true;
-			QueryParams.bTraceComplex = true;
-
-			// for smoke trail - set beam end point to line trace end point
-			FVector BeamEndPoint = TraceEnd;
-			FHitResult FinalBlockingHit;
-
-			// line trace outwards from crosshairs world location
-			GetWorld()->LineTraceSingleByChannel(ScreenTraceHit, TraceStart, TraceEnd, ECollisionChannel::ECC_Visibility, QueryParams);
-			//DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, 2.f);
-
-			// check hit result of trace for blocking hit
-			if (ScreenTraceHit.bBlockingHit)
+			if (GetHitScanConfig().bResolveAsync)
+			{ TracePelletsAsync(AimOrigin, TraceEnds); }
+			else
 			{
-				// smoke trail end point is now updated to trace hit location
-				BeamEndPoint = ScreenTraceHit.Location;
-				// the hit result that will ultimately be passed
-				FinalBlockingHit = ScreenTraceHit;
-				
-				PawnOwner->ReportAINoiseEventBP(1.f, FinalBlockingHit.Location, FName("BulletImpact"));
-		
-				if (AEnemy* HitEnemy = Cast<AEnemy>(FinalBlockingHit.GetActor()))
-				{ HandleHit(FinalBlockingHit, HitEnemy); }
-
-				// don't call impact particle FX if hit enemy (different FX, handled on enemy's damage application)
-				else if (ImpactParticles && BulletHoleDecal)
-				{
-					// spawn impact particle FX
-					UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), ImpactParticles, FinalBlockingHit.Location);
-					
-					// spawn bullet hole decal
-					FRotator RandomDecalRotation = FinalBlockingHit.ImpactNormal.Rotation();
-					RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
-					UDecalComponent* BulletHoleDecalComp = UGameplayStatics::SpawnDecalAttached(BulletHoleDecal, BulletHoleSize, FinalBlockingHit.GetComponent(), FinalBlockingHit.BoneName, FinalBlockingHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition);
-					BulletHoleDecalComp->SetFadeScreenSize(0.f);
-				}
+				TArray<FHitResult> PelletHits;
+				TracePellets(AimOrigin, TraceEnds, PelletHits);
+
+				ResolveShotHits(PelletHits);
 			}
 		}
 
@@ -593,7 +904,7 @@ void AWeapon::FireShot()
 void AWeapon::HandleRefiring()
 {
 	UWorld* World = GetWorld();
-	float SlackTimeThisFrame = FMath::Max(0.0f, (World->TimeSeconds - LastFireTime) - WeaponConfig.TimeBetweenShots);
+	float SlackTimeThisFrame = FMath::Max(0.0f, (World->TimeSeconds - LastFireTime) - GetWeaponData().TimeBetweenShots);
 
 	// compensate timer to maintain consistent rate of fire
 	if (bAllowAutomaticWeaponCatchup)
@@ -629,7 +940,7 @@ void AWeapon::HandleFiring()
 		//if (GetCurrentAmmoInInventory() == 0 && !bRefiring && !bHavePlayedOutOfAmmoSound && !bHasBeenFired)
 		if (GetCurrentAmmoInInventory() == 0 && !bRefiring)
 		{
-			PlayWeaponSound(OutOfAmmoSound);
+			PlayWeaponSound(GetArchetype().OutOfAmmoSound.Get());
 			bHavePlayedOutOfAmmoSound = true;
 		}
 
@@ -654,7 +965,7 @@ void AWeapon::HandleFiring()
 		// reload after firing last round in magazine
 		if (CurrentAmmoInClip <= 0)
 		{
-			WeaponMesh->PlayAnimation(WeaponEmptyAnim, true);
+			WeaponMesh->PlayAnimation(GetArchetype().WeaponEmptyAnim.Get(), true);
 			SetWeaponState(EWeaponState::Empty);
 
 			if (CanReload())
@@ -662,10 +973,10 @@ void AWeapon::HandleFiring()
 		}
 
 		// setup re-firing timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f);
+		bRefiring = (CurrentState == EWeaponState::Firing && GetWeaponData().TimeBetweenShots > 0.0f);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AWeapon::HandleRefiring, FMath::Max<float>(WeaponConfig.TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
+			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AWeapon::HandleRefiring, FMath::Max<float>(GetWeaponData().TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
 			TimerIntervalAdjustment = 0.f;
 		}
 	}
@@ -681,8 +992,8 @@ void AWeapon::OnBurstStarted()
 {
 	// start firing; can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f && LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
-	{ GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false); }
+	if (LastFireTime > 0 && GetWeaponData().TimeBetweenShots > 0.0f && LastFireTime + GetWeaponData().TimeBetweenShots > GameTime)
+	{ GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AWeapon::HandleFiring, LastFireTime + GetWeaponData().TimeBetweenShots - GameTime, false); }
 
 	else
 	{ HandleFiring(); }
@@ -743,11 +1054,11 @@ void AWeapon::DetermineWeaponState()
 	// set state + play any relevant looped idle anims
 	SetWeaponState(NewState);
 
-	if (NewState == EWeaponState::Idle && CurrentAmmoInClip == 0 && bHasBeenFired && WeaponEmptyAnim)
-	{ WeaponMesh->PlayAnimation(WeaponEmptyAnim, true); }
+	if (NewState == EWeaponState::Idle && CurrentAmmoInClip == 0 && bHasBeenFired && GetArchetype().WeaponEmptyAnim.Get())
+	{ WeaponMesh->PlayAnimation(GetArchetype().WeaponEmptyAnim.Get(), true); }
 
 	else if (NewState == EWeaponState::Idle)
-	{ WeaponMesh->PlayAnimation(WeaponIdleAnim, true); }
+	{ WeaponMesh->PlayAnimation(GetArchetype().WeaponIdleAnim.Get(), true); }
 }
 
 
@@ -760,7 +1071,7 @@ void AWeapon::AttachMeshToPawn()
 		DetachMeshFromPawn();
 
 		USkeletalMeshComponent* PawnMesh = PawnOwner->GetMesh();
-		AttachToComponent(PawnOwner->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, HolsterSocket);
+		AttachToComponent(PawnOwner->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, GetArchetype().HolsterSocket);
 	}
 }
 
@@ -778,13 +1089,14 @@ void AWeapon::DetachMeshFromPawn()
 
 
 // play weapon sounds
-UAudioComponent* AWeapon::PlayWeaponSound(USoundCue* Sound)
+FAudioVoiceHandle AWeapon::PlayWeaponSound(USoundCue* Sound)
 {
-	UAudioComponent* AC = NULL;
-	if (Sound && PawnOwner)
-	{ AC = UGameplayStatics::SpawnSoundAttached(Sound, PawnOwner->GetRootComponent()); }
+	FAudioVoiceHandle Voice;
+	UAudioVoiceSubsystem* VoicePool = GetWorld()->GetSubsystem<UAudioVoiceSubsystem>();
+	if (Sound && PawnOwner && VoicePool)
+	{ Voice = VoicePool->PlaySoundAttached(Sound, PawnOwner->GetRootComponent(), EAudioVoicePriority::AVP_Critical); }
 
-	return AC;
+	return Voice;
 }
 
 
@@ -810,8 +1122,8 @@ void AWeapon::StopPlayerWeaponAnimation(UAnimMontage* Animation)
 
 void AWeapon::PlayBulletCasingLandingSound()
 {
-	if (BulletCasingLandingSound)
-	{ UGameplayStatics::PlaySoundAtLocation(GetWorld(), BulletCasingLandingSound, PawnOwner->GetActorLocation(), BulletCasingVolumeMultiplier); }
+	if (USoundCue* BulletCasingLandingSound = GetArchetype().BulletCasingLandingSound.Get())
+	{ UGameplayStatics::PlaySoundAtLocation(GetWorld(), BulletCasingLandingSound, PawnOwner->GetActorLocation(), GetArchetype().BulletCasingVolumeMultiplier); }
 }
 
 
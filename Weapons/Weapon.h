@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "../Effects/AudioVoiceSubsystem.h"
 #include "Weapon.generated.h"
 
 class UAnimMontage;
@@ -14,6 +15,9 @@ class UCameraShake;
 class UForceFeedbackEffect;
 class USoundCue;
 class UNiagaraSystem;
+class UWeaponArchetype;
+struct FStreamableHandle;
+template<typename ValueType> struct THitZoneTable;
 
 
 UENUM(BlueprintType)
@@ -65,6 +69,9 @@ struct FHitScanConfiguration
 		Distance = 10000.f;
 		Damage = 25.f;
 		Radius = 0.f;
+		PelletCount = 1;
+		PelletSpread = 0.f;
+		bResolveAsync = false;
 		DamageType = UDamageType::StaticClass();
 	}
 
@@ -84,6 +91,18 @@ struct FHitScanConfiguration
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TraceInfo")
 	float Radius;
 
+	// traces per shot (e.g., shotgun pellets); damage from all pellets hitting one enemy is applied as a single hit
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TraceInfo", meta = (ClampMin = "1"))
+	int32 PelletCount;
+
+	// half-angle (degrees) of the cone pellets are spread in
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TraceInfo", meta = (ClampMin = "0"))
+	float PelletSpread;
+
+	// issue the shot's traces through the async trace API and resolve hits (damage, FX, noise) at the start of next frame
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TraceInfo")
+	bool bResolveAsync;
+
 	// type of damage dealt
 	UPROPERTY(EditDefaultsOnly, Category = "WeaponStats")
 	TSubclassOf<UDamageType> DamageType;
@@ -91,6 +110,16 @@ struct FHitScanConfiguration
 };
 
 
+// a fired shot whose pellet traces are still in flight (async hitscan)
+struct FPendingShot
+{
+	FVector Origin;
+	uint64 FrameIssued;
+	TArray<FVector> TraceEnds;
+	TArray<FTraceHandle> TraceHandles;
+};
+
+
 UCLASS()
 class ESCAPEROOMPROJECT_API AWeapon : public AActor
 {
@@ -116,159 +145,38 @@ protected:
 	UPROPERTY()
 	class APlayerCharacter* PawnOwner;
 
-	// weapon data
+	// shared config for this kind of weapon (tuning, sockets, FX, sounds, anims), read straight from there at runtime (see
+	// GetArchetype); its assets are streamed in on first equip. required: a weapon without one fails data validation
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
-	FWeaponData WeaponConfig;
+	UWeaponArchetype* Archetype;
 
-	// line trace data
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
-	FHitScanConfiguration HitScanConfig;
+	// Archetype, or a read-only fallback if it is missing anyway (the legacy config in the editor, class defaults in a cooked build)
+	const UWeaponArchetype& GetArchetype() const;
 
-	// firing audio
-	UPROPERTY(Transient)
-	UAudioComponent* FireAC;
+#if WITH_EDITOR
+	// move this weapon's legacy config (below) onto a new archetype asset next to it, and point it there
+	UFUNCTION(CallInEditor, Category = "Config")
+	void MigrateToArchetype();
+#endif
 
-	// name of bone/socket for muzzle in weapon mesh
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	FName MuzzleAttachPoint;
+	// keeps the archetype's streamed assets resident while this weapon exists
+	TSharedPtr<FStreamableHandle> ArchetypeAssetsHandle;
 
-	// name of socket to attach to the character on, hand
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	FName AttachSocket;
+	bool bArchetypeAssetsLoaded;
 
-	// name of socket to attach to the character on, holster
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	FName HolsterSocket;
+	// BoneDamageModifiers, registered with UHitZoneSubsystem on BeginPlay (their tables are compiled for every enemy mesh then)
+	int32 DamageMapId;
 
-	// muzzle flash FX
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	UParticleSystem* MuzzleFX;
-
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	UNiagaraSystem* BulletEjectionFX;
+	// that map compiled against the mesh last hit
+	TSharedPtr<const THitZoneTable<float>> DamageZones;
 
-	// FX for impact particles (spawned on bullet impact)
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	UNiagaraSystem* ImpactParticles;
-
-	// FX for beam particles (smoke trail for bullets)
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	UParticleSystem* BeamParticles;
+	// firing audio (looped fire sound's pooled voice)
+	FAudioVoiceHandle FireVoice;
 
 	// spawned component for muzzle FX
 	UPROPERTY(Transient)
 	UParticleSystemComponent* MuzzlePSC;
 
-	// time required to aim down sights, in seconds
-	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
-	float ADSTime;
-
-	// amount of recoil to apply
-	UPROPERTY(EditDefaultsOnly, Category = "Recoil")
-	class UCurveVector* RecoilCurve;
-
-	// speed at which the recoil bumps up, per second
-	UPROPERTY(EditDefaultsOnly, Category = "Recoil")
-	float RecoilSpeed;
-
-	// speed at which the recoil resets, per second
-	UPROPERTY(EditDefaultsOnly, Category = "Recoil")
-	float RecoilResetSpeed;
-
-	// force feedback effect (controller vibration) to play when the weapon is fired
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	UForceFeedbackEffect* FireForceFeedback;
-
-	// how long after firing to wait until playing the sound of the casing hitting the ground
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	float BulletCasingSoundDelay;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	float BulletCasingVolumeMultiplier;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	UMaterialInstance* BulletHoleDecal;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	UMaterialInstance* BloodBulletHoleDecal;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	FVector BulletHoleSize;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	FVector BloodBulletHoleSize;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FX")
-	float BulletHoleLifespan;
-	
-	/**
-	*  sound and animation
-	*/
-
-	// single shot fired sound
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* FireSound;
-
-	// looped fire sound (bLoopedFireSound set)
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* FireLoopSound;
-
-	// finished firing sound (bLoopedFireSound set)
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* FireFinishSound;
-
-	// out of ammo sound
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* OutOfAmmoSound;
-
-	// reload sound
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* ReloadSound;
-
-	// sound of spent bullet casing hitting the ground
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* BulletCasingLandingSound;
-
-	// reload animation: player making reload motions with gun lowered
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* LoweredReloadAnim;
-
-	// reload animation: player making reload motions with gun raised
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* AimingReloadAnim;
-
-	// reload animation: weapon itself being reloaded
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* WeaponReloadAnim;
-
-	// equip sound
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	USoundCue* EquipSound;
-
-	// equip anim (player drawing from holster)
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* EquipAnim;
-
-	// unequip anim (player holstering weapon)
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* UnequipAnim;
-
-	// firing anim: player character pulling trigger
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* FireAnim;
-
-	// firing anim: weapon itself firing
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimationAsset* WeaponFireAnim;
-
-	// empty anim: weapon itself out of ammo
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimationAsset* WeaponEmptyAnim;
-
-	// idle anim: weapon itself, neither firing, empty, nor reloading
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimationAsset* WeaponIdleAnim;
-
 	/**
 	*  flags
 	*/
@@ -282,18 +190,6 @@ protected:
 	// is fire anim playing?
 	uint32 bPlayingFireAnim : 1;
 
-	// is fire sound looped?
-	UPROPERTY(EditDefaultsOnly, Category = "Sound")
-	uint32 bLoopedFireSound : 1;
-
-	// is fire animation looped?
-	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	uint32 bLoopedFireAnim : 1;
-
-	// are muzzle FX looped?
-	UPROPERTY(EditDefaultsOnly, Category = "FX")
-	uint32 bLoopedMuzzleFX : 1;
-
 	// is weapon currently equipped?
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	uint32 bIsEquipped : 1;
@@ -366,14 +262,154 @@ protected:
 
 	FVector LastBulletImpactLocation;
 
+	// async shots fired last frame, resolved in Tick
+	TArray<FPendingShot> PendingShots;
+
+#if WITH_EDITORONLY_DATA
+	/*
+	*  legacy config, from before weapon archetypes. not edited or read at runtime any more; only still loaded from older
+	*  blueprints so MigrateToArchetype can move it onto an archetype (same names as UWeaponArchetype's)
+	*/
+
+	UPROPERTY()
+	FWeaponData WeaponConfig;
+
+	UPROPERTY()
+	FHitScanConfiguration HitScanConfig;
+
+	UPROPERTY()
+	FName MuzzleAttachPoint;
+
+	UPROPERTY()
+	FName AttachSocket;
+
+	UPROPERTY()
+	FName HolsterSocket;
+
+	UPROPERTY()
+	float ADSTime;
+
+	UPROPERTY()
+	class UCurveVector* RecoilCurve;
+
+	UPROPERTY()
+	float RecoilSpeed;
+
+	UPROPERTY()
+	float RecoilResetSpeed;
+
+	UPROPERTY()
+	UParticleSystem* MuzzleFX;
+
+	UPROPERTY()
+	UNiagaraSystem* BulletEjectionFX;
+
+	UPROPERTY()
+	UNiagaraSystem* ImpactParticles;
+
+	UPROPERTY()
+	UParticleSystem* BeamParticles;
+
+	UPROPERTY()
+	UForceFeedbackEffect* FireForceFeedback;
+
+	UPROPERTY()
+	float BulletCasingSoundDelay;
+
+	UPROPERTY()
+	float BulletCasingVolumeMultiplier;
+
+	UPROPERTY()
+	UMaterialInstance* BulletHoleDecal;
+
+	UPROPERTY()
+	UMaterialInstance* BloodBulletHoleDecal;
+
+	UPROPERTY()
+	FVector BulletHoleSize;
+
+	UPROPERTY()
+	FVector BloodBulletHoleSize;
+
+	UPROPERTY()
+	float BulletHoleLifespan;
+
+	UPROPERTY()
+	USoundCue* FireSound;
+
+	UPROPERTY()
+	USoundCue* FireLoopSound;
+
+	UPROPERTY()
+	USoundCue* FireFinishSound;
+
+	UPROPERTY()
+	USoundCue* OutOfAmmoSound;
+
+	UPROPERTY()
+	USoundCue* ReloadSound;
+
+	UPROPERTY()
+	USoundCue* BulletCasingLandingSound;
+
+	UPROPERTY()
+	USoundCue* EquipSound;
+
+	UPROPERTY()
+	UAnimMontage* LoweredReloadAnim;
+
+	UPROPERTY()
+	UAnimMontage* AimingReloadAnim;
+
+	UPROPERTY()
+	UAnimMontage* WeaponReloadAnim;
+
+	UPROPERTY()
+	UAnimMontage* EquipAnim;
+
+	UPROPERTY()
+	UAnimMontage* UnequipAnim;
+
+	UPROPERTY()
+	UAnimMontage* FireAnim;
+
+	UPROPERTY()
+	UAnimationAsset* WeaponFireAnim;
+
+	UPROPERTY()
+	UAnimationAsset* WeaponEmptyAnim;
+
+	UPROPERTY()
+	UAnimationAsset* WeaponIdleAnim;
+
+	UPROPERTY()
+	uint32 bLoopedFireSound : 1;
+
+	UPROPERTY()
+	uint32 bLoopedFireAnim : 1;
+
+	UPROPERTY()
+	uint32 bLoopedMuzzleFX : 1;
+
+	// built from the legacy config for weapons without an archetype, so they still play as authored in the editor
+	UPROPERTY(Transient)
+	mutable UWeaponArchetype* LegacyArchetype;
+#endif
+
 public:
 
 	// called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void Tick(float DeltaTime) override;
+
 	virtual void PostInitializeComponents() override;
 	virtual void Destroyed() override;
 
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
 protected:
 	
 	// consume a bullet from the magazine
@@ -440,7 +476,7 @@ protected:
 	FORCEINLINE int32 GetCurrentAmmoInClip() const { return CurrentAmmoInClip; }
 
 	// get magazine size
-	FORCEINLINE int32 GetAmmoPerClip() const { return WeaponConfig.AmmoPerClip; }
+	int32 GetAmmoPerClip() const;
 
 	// get weapon mesh
 	UFUNCTION(BlueprintPure, Category = "Weapon")
@@ -464,8 +500,42 @@ protected:
 	virtual void SimulateWeaponFire();
 	virtual void StopSimulatingWeaponFire();
 
-	// process the hit
-	void HandleHit(const FHitResult& Hit, class AEnemy* HitEnemy = nullptr);
+	// the archetype's config
+	const FWeaponData& GetWeaponData() const;
+	const FHitScanConfiguration& GetHitScanConfig() const;
+
+	// register the archetype's damage map
+	void ApplyArchetype();
+
+	void LoadArchetypeAssets();
+	void OnArchetypeAssetsLoaded();
+
+	void PrewarmPooledFX();
+
+	// apply a shot's (pellet-aggregated) damage to an enemy
+	void HandleHit(const FHitResult& Hit, class AEnemy* HitEnemy, float Damage);
+
+	// bone-specific damage modifier for a hit (1 if none)
+	float GetBoneDamageMultiplier(const FHitResult& Hit);
+
+	void SpawnBulletHoleDecal(UMaterialInstance* DecalMaterial, const FVector& DecalSize, const FHitResult& Hit);
+
+	// world position + direction of the crosshairs
+	bool GetShotAim(FVector& OutOrigin, FVector& OutDirection) const;
+
+	void BuildPelletTraceEnds(const FVector& Origin, const FVector& Direction, TArray<FVector>& OutTraceEnds) const;
+
+	FCollisionQueryParams GetShotQueryParams() const;
+
+	void TracePellets(const FVector& Origin, const TArray<FVector>& TraceEnds, TArray<FHitResult>& OutHits) const;
+
+	// issue every pellet's trace through the async trace API; hits are resolved by ResolvePendingShots next frame
+	void TracePelletsAsync(const FVector& Origin, const TArray<FVector>& TraceEnds);
+
+	void ResolvePendingShots();
+
+	// impacts, decals and per-enemy aggregated damage for one shot's pellet hits
+	void ResolveShotHits(const TArray<FHitResult>& PelletHits);
 
 	// weapon-specific fire implementation
 	virtual void FireShot();
@@ -497,7 +567,7 @@ protected:
 	*/
 
 	// play weapon sounds
-	UAudioComponent* PlayWeaponSound(USoundCue* Sound);
+	FAudioVoiceHandle PlayWeaponSound(USoundCue* Sound);
 
 	// play weapon animations on the player character
 	float PlayPlayerWeaponAnimation(UAnimMontage* Animation, float PlayRate);
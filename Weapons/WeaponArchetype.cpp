@@ -0,0 +1,51 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+
+#include "../Weapons/WeaponArchetype.h"
+
+
+// sets default values
+UWeaponArchetype::UWeaponArchetype()
+{
+	AttachSocket = FName("Pistol_Socket");
+	ADSTime = 0.5f;
+	RecoilSpeed = 10.f;
+	RecoilResetSpeed = 5.f;
+
+	BulletHoleSize = FVector(3.f, 3.f, 3.f);
+	BloodBulletHoleSize = FVector(1.5f, 1.5f, 1.5f);
+	BulletHoleLifespan = 300.f;
+	BulletCasingSoundDelay = 1.f;
+	BulletCasingVolumeMultiplier = .75f;
+
+	bLoopedMuzzleFX = false;
+	bLoopedFireSound = false;
+	bLoopedFireAnim = false;
+}
+
+
+FPrimaryAssetId UWeaponArchetype::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FPrimaryAssetType("WeaponArchetype"), GetFName());
+}
+
+
+void UWeaponArchetype::GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+{
+	const FSoftObjectPath SoftAssets[] =
+	{
+		RecoilCurve.ToSoftObjectPath(), MuzzleFX.ToSoftObjectPath(), BulletEjectionFX.ToSoftObjectPath(), ImpactParticles.ToSoftObjectPath(),
+		BeamParticles.ToSoftObjectPath(), FireForceFeedback.ToSoftObjectPath(), BulletHoleDecal.ToSoftObjectPath(), BloodBulletHoleDecal.ToSoftObjectPath(),
+		FireSound.ToSoftObjectPath(), FireLoopSound.ToSoftObjectPath(), FireFinishSound.ToSoftObjectPath(), OutOfAmmoSound.ToSoftObjectPath(),
+		ReloadSound.ToSoftObjectPath(), BulletCasingLandingSound.ToSoftObjectPath(), EquipSound.ToSoftObjectPath(),
+		LoweredReloadAnim.ToSoftObjectPath(), AimingReloadAnim.ToSoftObjectPath(), WeaponReloadAnim.ToSoftObjectPath(), EquipAnim.ToSoftObjectPath(),
+		UnequipAnim.ToSoftObjectPath(), FireAnim.ToSoftObjectPath(), WeaponFireAnim.ToSoftObjectPath(), WeaponEmptyAnim.ToSoftObjectPath(),
+		WeaponIdleAnim.ToSoftObjectPath()
+	};
+
+	for (const FSoftObjectPath& SoftAsset : SoftAssets)
+	{
+		if (!SoftAsset.IsNull())
+		{ OutAssets.AddUnique(SoftAsset); }
+	}
+}
@@ -0,0 +1,176 @@
+// Copyright 2022 Andrew Creekmore, Danny Chung, Brittany Legget
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "../Weapons/Weapon.h"
+#include "WeaponArchetype.generated.h"
+
+class UAnimationAsset;
+class UAnimMontage;
+class UCurveVector;
+class UForceFeedbackEffect;
+class UMaterialInstance;
+class UNiagaraSystem;
+class UParticleSystem;
+class USoundCue;
+
+/**
+ *  shared, read-only configuration for one kind of weapon. every AWeapon of that kind points at the same archetype
+ *  instead of carrying its own copy; asset references are soft and only streamed in when the weapon is equipped
+ */
+UCLASS(BlueprintType)
+class ESCAPEROOMPROJECT_API UWeaponArchetype : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UWeaponArchetype();
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// every soft asset reference, for streaming on equip
+	void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const;
+
+	/*
+	*  config
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	FWeaponData WeaponConfig;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	FHitScanConfiguration HitScanConfig;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	FName MuzzleAttachPoint;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	FName AttachSocket;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	FName HolsterSocket;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Config")
+	float ADSTime;
+
+	/*
+	*  recoil
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Recoil")
+	TSoftObjectPtr<UCurveVector> RecoilCurve;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Recoil")
+	float RecoilSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Recoil")
+	float RecoilResetSpeed;
+
+	/*
+	*  FX
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UParticleSystem> MuzzleFX;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UNiagaraSystem> BulletEjectionFX;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UNiagaraSystem> ImpactParticles;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UParticleSystem> BeamParticles;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UForceFeedbackEffect> FireForceFeedback;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UMaterialInstance> BulletHoleDecal;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	TSoftObjectPtr<UMaterialInstance> BloodBulletHoleDecal;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	FVector BulletHoleSize;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	FVector BloodBulletHoleSize;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	float BulletHoleLifespan;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	float BulletCasingSoundDelay;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	float BulletCasingVolumeMultiplier;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FX")
+	bool bLoopedMuzzleFX;
+
+	/*
+	*  sound
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> FireSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> FireLoopSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> FireFinishSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> OutOfAmmoSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> ReloadSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> BulletCasingLandingSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	TSoftObjectPtr<USoundCue> EquipSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
+	bool bLoopedFireSound;
+
+	/*
+	*  animation
+	*/
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> LoweredReloadAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> AimingReloadAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> WeaponReloadAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> EquipAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> UnequipAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimMontage> FireAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimationAsset> WeaponFireAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimationAsset> WeaponEmptyAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	TSoftObjectPtr<UAnimationAsset> WeaponIdleAnim;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	bool bLoopedFireAnim;
+};
@@ -4,6 +4,7 @@
 #include "../World/Pickup.h"
 #include "../DebugMacros.h"
 #include "../Items/Item.h"
+#include "../Items/ItemAssetStreamer.h"
 #include "../Components/InventoryComponent.h"
 #include "../Components/InteractionComponent.h"
 #include "../World/PickupContainer.h"
@@ -24,6 +25,18 @@ APickup::APickup()
 	InteractionComponent->InteractionDistance = 200.0f;
 	InteractionComponent->SetupAttachment(PickupMeshComponent);
 
+#if WITH_EDITORONLY_DATA
+	EditorPreviewMeshComponent = CreateEditorOnlyDefaultSubobject<UStaticMeshComponent>("EditorPreviewMesh");
+	if (EditorPreviewMeshComponent)
+	{
+		EditorPreviewMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		EditorPreviewMeshComponent->SetHiddenInGame(true);
+		EditorPreviewMeshComponent->SetupAttachment(PickupMeshComponent);
+	}
+#endif
+
+	PlaceholderMesh = nullptr;
+
 	PickupID = MakeUniqueObjectName(GetOuter(), GetClass());
 }
 
@@ -32,26 +45,40 @@ void APickup::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// the instanced template is already an item owned by this pickup; use it rather than a copy
 	if (ItemTemplate)
-	{ InitializePickup(ItemTemplate->GetClass(), ItemTemplate->GetQuantity()); }
+	{
+		Item = ItemTemplate;
+		InitializePickup(ItemTemplate->GetClass(), ItemTemplate->GetQuantity());
+	}
 }
 
 
-#if WITH_EDITOR
-void APickup::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+void APickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (UItemAssetStreamer* Streamer = UItemAssetStreamer::Get(this))
+	{ Streamer->UnregisterPickup(this); }
 
-	FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-
-	// if a new pickup is selected in the property editor, change the mesh to reflect the new item being selected
-	if (PropertyName == GET_MEMBER_NAME_CHECKED(APickup, ItemTemplate))
-	{
-		if (ItemTemplate)
-		{ PickupMeshComponent->SetStaticMesh(ItemTemplate->PickupMesh); }
-	}
+	Super::EndPlay(EndPlayReason);
 }
+
+
+// editor: preview the selected item's mesh (re-run whenever ItemTemplate changes); in game the item asset streamer sets the real mesh
+void APickup::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+#if WITH_EDITORONLY_DATA
+	if (EditorPreviewMeshComponent == nullptr || GetWorld() == nullptr || GetWorld()->IsGameWorld()) { return; }
+
+	const bool bHasItemMesh = ItemTemplate && !ItemTemplate->GetPickupMeshAsset().IsNull();
+	EditorPreviewMeshComponent->SetStaticMesh(bHasItemMesh ? ItemTemplate->GetPickupMeshAsset().LoadSynchronous() : nullptr);
+
+	// the pickup's own mesh only ever holds the placeholder outside of play
+	if (bHasItemMesh)
+	{ PickupMeshComponent->SetStaticMesh(PlaceholderMesh); }
 #endif
+}
 
 
 // called on interaction
@@ -70,13 +97,13 @@ FText APickup::OnTakePickup(APlayerCharacter* Taker)
 			if (AddResult.ActualAmountGiven >= Item->GetQuantity())
 			{
 				// record pickup ID so we know whether to spawn pickup in world on save game load
-				if (!Item->bStackable)
+				if (!Item->IsStackable())
 				{ 
 					PlayerInventory->NonStackablePickupsTaken.Add(PickupID); 
 					PlayerInventory->NonStackablePickupsTakenLocations.Add(PickupLocationID);
 				}
 
-				if (Item->bStackable)
+				if (Item->IsStackable())
 				{	
 					PlayerInventory->StackablePickupsTakenToLocationMap.Emplace(PickupID, GetActorLocation());
 					PlayerInventory->LocationToStackablePickupsTakenMap.Emplace(GetActorLocation(), PickupID);
@@ -98,7 +125,7 @@ FText APickup::OnTakePickup(APlayerCharacter* Taker)
 				// self-destruct
 				Destroy();
 				// notify player
-				ResultText = FText::Format(LOCTEXT("SuccessText", "You got the {ItemName}."), Item->ItemDisplayName);
+				ResultText = FText::Format(LOCTEXT("SuccessText", "You got the {ItemName}."), Item->GetDisplayName());
 			}
 
 			// added some
@@ -121,16 +148,34 @@ void APickup::OnItemModified()
 {
 }
 
-// initializes a new UItem object, sets quantity and Pickup's mesh
+// initializes the pickup's UItem object (reusing the current one if it is the same class), sets quantity and Pickup's mesh
 void APickup::InitializePickup(const TSubclassOf<class UItem> ItemClass, const int32 Quantity)
 {
 	if (ItemClass && Quantity > 0) 
 	{
-		Item = NewObject<UItem>(this, ItemClass);
+		if (Item == nullptr || Item->GetClass() != ItemClass)
+		{ Item = NewObject<UItem>(this, ItemClass); }
+
 		Item->SetQuantity(Quantity);
-		PickupMeshComponent->SetStaticMesh(Item->PickupMesh);
-		Item->OnItemModified.AddDynamic(this, &APickup::OnItemModified);
+		Item->OnItemModified.AddUniqueDynamic(this, &APickup::OnItemModified);
+
+		// mesh already resident: use it now; otherwise show the placeholder until it is streamed in as the player comes near
+		UItemAssetStreamer* Streamer = UItemAssetStreamer::Get(this);
+		if (Item->GetPickupMesh() || Item->GetPickupMeshAsset().IsNull() || Streamer == nullptr)
+		{ OnPickupAssetsLoaded(); }
+		else
+		{
+			PickupMeshComponent->SetStaticMesh(PlaceholderMesh);
+			Streamer->RegisterPickup(this);
+		}
 	}
 }
 
+
+void APickup::OnPickupAssetsLoaded()
+{
+	if (Item)
+	{ PickupMeshComponent->SetStaticMesh(Item->GetPickupMesh()); }
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
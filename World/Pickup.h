@@ -26,6 +26,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pickup")
 	class UStaticMeshComponent* PickupMeshComponent;
 
+	// cheap stand-in shown while the item's own mesh is still being streamed in (see UItemAssetStreamer)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pickup")
+	class UStaticMesh* PlaceholderMesh;
+
+#if WITH_EDITORONLY_DATA
+	// the item's mesh, previewed in the editor only; editor-only components aren't cooked, so levels don't hard-reference their items' meshes
+	UPROPERTY()
+	class UStaticMeshComponent* EditorPreviewMeshComponent;
+#endif
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pickup")
 	class UInteractionComponent* InteractionComponent;
 
@@ -39,15 +49,15 @@ protected:
 	// called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Pickup")
 	class UItem* Item;
 
 	UPROPERTY(EditAnywhere, Instanced, BlueprintReadWrite, Category = "Pickup")
 	class UItem* ItemTemplate;
 
-#if WITH_EDITOR
-	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
-#endif
+	virtual void OnConstruction(const FTransform& Transform) override;
 
 	UFUNCTION(BlueprintCallable)
 	FText OnTakePickup(class APlayerCharacter* Taker);
@@ -59,4 +69,9 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void InitializePickup(const TSubclassOf<class UItem> ItemClass, const int32 Quantity);
+
+	FORCEINLINE class UItem* GetItem() const { return Item; }
+
+	// called by the item asset streamer once this pickup's item mesh is resident
+	void OnPickupAssetsLoaded();
 };